@@ -0,0 +1,612 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include "../include/figure.h"
+#include "../include/square.h"
+#include "../include/rectangle.h"
+#include "../include/triangle.h"
+#include "../include/array.h"
+#include "../include/static_array.h"
+#include "../include/batch_validity.h"
+#include "../include/spatial_index.h"
+#include "../include/binary_io.h"
+#include "../include/mapped_view.h"
+#include "../include/text_loader.h"
+#include "../include/report_writer.h"
+#include "../include/concurrent_array.h"
+#include "../include/statistics.h"
+#include "../include/collision.h"
+#include "../include/union_area.h"
+#include "../include/points.h"
+
+// Размеры массивов: 1e2 ... 1e7
+static void figureCounts(benchmark::internal::Benchmark* bench) {
+    bench->RangeMultiplier(10)->Range(100, 10'000'000)->Unit(benchmark::kMicrosecond);
+}
+
+// Набор фигур трёх видов с разными размерами
+template <typename T>
+static std::vector<std::shared_ptr<Figure<T>>> makeFigures(size_t count) {
+    std::vector<std::shared_ptr<Figure<T>>> figures;
+    figures.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        T s = static_cast<T>(1 + i % 17);
+        T o = static_cast<T>(i % 1000);
+        switch (i % 3) {
+            case 0:
+                figures.push_back(std::make_shared<Triangle<T>>(
+                    Point<T>(o, o), Point<T>(o + s, o), Point<T>(o, o + s)));
+                break;
+            case 1:
+                figures.push_back(std::make_shared<Square<T>>(
+                    Point<T>(o, o), Point<T>(o + s, o), Point<T>(o + s, o + s), Point<T>(o, o + s)));
+                break;
+            default:
+                figures.push_back(std::make_shared<Rectangle<T>>(
+                    Point<T>(o, o), Point<T>(o + 2 * s, o), Point<T>(o + 2 * s, o + s), Point<T>(o, o + s)));
+                break;
+        }
+    }
+    return figures;
+}
+
+template <typename T>
+static FigureArray<T> makeArray(size_t count) {
+    FigureArray<T> array;
+    for (auto& figure : makeFigures<T>(count)) {
+        array.add(std::move(figure));
+    }
+    return array;
+}
+
+template <typename T>
+static StaticFigureArray<T> makeStaticArray(size_t count) {
+    StaticFigureArray<T> array;
+    for (const auto& figure : makeFigures<T>(count)) {
+        array.add(figure);
+    }
+    return array;
+}
+
+// FigureArray::add - заполнение массива из n готовых фигур (включая перевыделения)
+template <typename T>
+static void BM_Add(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    auto figures = makeFigures<T>(count);
+    for (auto _ : state) {
+        FigureArray<T> array;
+        for (const auto& figure : figures) {
+            array.add(figure);
+        }
+        benchmark::DoNotOptimize(array.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// FigureArray::emplace - построение короткоживущего массива в арене против make_shared + add
+template <typename T>
+static void BM_EmplaceArena(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        FigureArray<T> array(std::pmr::get_default_resource());
+        for (size_t i = 0; i < count; ++i) {
+            array.template emplace<Square<T>>();
+        }
+        benchmark::DoNotOptimize(array.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+template <typename T>
+static void BM_MakeSharedAdd(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        FigureArray<T> array;
+        for (size_t i = 0; i < count; ++i) {
+            array.add(std::make_shared<Square<T>>());
+        }
+        benchmark::DoNotOptimize(array.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// FigureArray::erase - удаление из середины с последующим добавлением (размер не меняется)
+template <typename T>
+static void BM_Erase(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T> array = makeArray<T>(count);
+    auto figure = std::make_shared<Square<T>>();
+    for (auto _ : state) {
+        array.erase(count / 2);
+        array.add(figure);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// FigureArray::eraseUnordered - удаление без сдвига
+template <typename T>
+static void BM_EraseUnordered(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T> array = makeArray<T>(count);
+    auto figure = std::make_shared<Square<T>>();
+    for (auto _ : state) {
+        array.eraseUnordered(count / 2);
+        array.add(figure);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// FigureArray::eraseIf - удаление каждой десятой фигуры за один проход
+template <typename T>
+static void BM_EraseIf(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    auto figures = makeFigures<T>(count);
+    for (auto _ : state) {
+        state.PauseTiming();
+        FigureArray<T> array;
+        for (const auto& figure : figures) {
+            array.add(figure);
+        }
+        size_t position = 0;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(array.eraseIf([&](const Figure<T>&) { return position++ % 10 == 0; }));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// FigureArray::computeTotalArea
+template <typename T>
+static void BM_ComputeTotalArea(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T> array = makeArray<T>(count);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(array.computeTotalArea());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// FigureArray::computeTotalAreaParallel на общем пуле потоков
+template <typename T>
+static void BM_ComputeTotalAreaParallel(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T> array = makeArray<T>(count);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(array.computeTotalAreaParallel());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// StaticFigureArray::computeTotalArea - то же, без виртуальных вызовов
+template <typename T>
+static void BM_StaticComputeTotalArea(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    StaticFigureArray<T> array = makeStaticArray<T>(count);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(array.computeTotalArea());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// FigureArray::operator[] - последовательный доступ ко всем элементам
+template <typename T>
+static void BM_IndexOperator(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T> array = makeArray<T>(count);
+    for (auto _ : state) {
+        for (size_t i = 0; i < count; ++i) {
+            benchmark::DoNotOptimize(&array[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// Figure::operator== - сравнение соседних фигур (виды чередуются, как в реальных данных)
+template <typename T>
+static void BM_FigureEquality(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T> array = makeArray<T>(count);
+    for (auto _ : state) {
+        size_t equal = 0;
+        for (size_t i = 0; i + 3 < count; ++i) {
+            equal += array[i] == array[i + 3];
+        }
+        benchmark::DoNotOptimize(equal);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// Figure::checkValidity
+template <typename T>
+static void BM_CheckValidity(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T> array = makeArray<T>(count);
+    for (auto _ : state) {
+        size_t valid = 0;
+        for (size_t i = 0; i < count; ++i) {
+            valid += array[i].checkValidity();
+        }
+        benchmark::DoNotOptimize(valid);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// batchCheckValidity - проверка упакованных фигур одного вида (то же множество, что в BM_CheckValidity)
+template <typename T>
+static void BM_BatchCheckValidity(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureColumnStore<T> store(makeArray<T>(count));
+    std::vector<double> xs[3], ys[3];
+    std::vector<size_t> indices;
+    FigureKind kinds[3] = {FigureKind::Triangle, FigureKind::Square, FigureKind::Rectangle};
+    for (size_t k = 0; k < 3; ++k) {
+        store.packKind(kinds[k], xs[k], ys[k], indices);
+    }
+    std::vector<ValidityReason> reasons(count);
+    for (auto _ : state) {
+        ValidityReason* out = reasons.data();
+        for (size_t k = 0; k < 3; ++k) {
+            size_t n = xs[k].size() / (kinds[k] == FigureKind::Triangle ? 3 : 4);
+            batchCheckValidity(kinds[k], xs[k].data(), ys[k].data(), n, out);
+            out += n;
+        }
+        benchmark::DoNotOptimize(reasons.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// FigureArray::findDuplicates - поиск повторов через хеш канонических форм
+template <typename T>
+static void BM_FindDuplicates(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T> array = makeArray<T>(count);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(array.findDuplicates());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// SpatialIndex::queryWindow - небольшое окно над всем набором фигур
+template <typename T>
+static void BM_SpatialWindowQuery(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T> array = makeArray<T>(count);
+    SpatialIndex<T> index(array);
+    BoundingBox<T> window{T(100), T(100), T(110), T(110)};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.queryWindow(window));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Снимок массива в двоичном формате (фигуры сгруппированы по видам)
+template <typename T>
+static std::string makeSnapshot(size_t count) {
+    std::stringstream stream;
+    writeFigureArray(stream, makeArray<T>(count), FigureOrder::GroupByKind);
+    return stream.str();
+}
+
+// readFigureArray - загрузка снимка с созданием объектов фигур
+template <typename T>
+static void BM_BinaryRead(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::string data = makeSnapshot<T>(count);
+    for (auto _ : state) {
+        std::istringstream input(data);
+        benchmark::DoNotOptimize(readFigureArray<T>(input).size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+
+// readFigureColumnStore - загрузка снимка в колоночное хранилище
+template <typename T>
+static void BM_BinaryReadColumns(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::string data = makeSnapshot<T>(count);
+    for (auto _ : state) {
+        std::istringstream input(data);
+        benchmark::DoNotOptimize(readFigureColumnStore<T>(input).size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(data.size()));
+}
+
+// MappedFigureView - открытие снимка и суммарная площадь без загрузки фигур
+template <typename T>
+static void BM_MappedTotalArea(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::string data = makeSnapshot<T>(count);
+    std::vector<uint64_t> buffer((data.size() + 7) / 8);
+    std::memcpy(buffer.data(), data.data(), data.size());
+    for (auto _ : state) {
+        MappedFigureView<T> view(buffer.data(), data.size());
+        benchmark::DoNotOptimize(view.computeTotalArea());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// Текстовый дамп "kind x y ..." для бенчмарков загрузки
+template <typename T>
+static std::string makeTextDump(size_t count) {
+    FigureArray<T> array = makeArray<T>(count);
+    std::ostringstream out;
+    for (size_t i = 0; i < array.size(); ++i) {
+        const Figure<T>& figure = array[i];
+        static const char* names[] = {"triangle", "square", "rectangle"};
+        out << names[static_cast<size_t>(figure.kind())];
+        for (size_t v = 0; v < figure.vertexCount(); ++v) {
+            out << ' ' << figure.getVertex(v).getX() << ' ' << figure.getVertex(v).getY();
+        }
+        out << '\n';
+    }
+    return out.str();
+}
+
+// loadFiguresText - разбор текстового дампа через from_chars в колоночное хранилище
+template <typename T>
+static void BM_TextLoad(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    std::string text = makeTextDump<T>(count);
+    for (auto _ : state) {
+        FigureColumnStore<T> store;
+        benchmark::DoNotOptimize(loadFiguresText(text, store).loaded);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+
+// ReportWriter - отчёт о площадях в формате CSV в строку
+template <typename T>
+static void BM_ReportAreasCsv(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T> array = makeArray<T>(count);
+    std::string report;
+    for (auto _ : state) {
+        report.clear();
+        StringSink sink(report);
+        ReportWriter writer(sink, ReportFormat::Csv);
+        writer.writeAreas(array);
+        writer.flush();
+        benchmark::DoNotOptimize(report.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(report.size()));
+}
+
+// computeFigureStatistics - все показатели по видам за один параллельный проход
+template <typename T>
+static void BM_FigureStatistics(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T> array = makeArray<T>(count);
+    StatisticsOptions options;
+    options.histogramEdges = {1, 10, 100, 1000};
+    for (auto _ : state) {
+        FigureStatistics stats = computeFigureStatistics(array, options);
+        benchmark::DoNotOptimize(stats.all.sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// FigureArray::sortBy и topK по площади (массив перемешивается заново вне замера)
+template <typename T>
+static void BM_SortByArea(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T> array = makeArray<T>(count);
+    for (auto _ : state) {
+        state.PauseTiming();
+        array.sortBy(CentroidXKey{});
+        state.ResumeTiming();
+        array.sortBy(AreaKey{}, SortOrder::Descending);
+        benchmark::DoNotOptimize(&array[0]);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+template <typename T>
+static void BM_TopK(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T> array = makeArray<T>(count);
+    for (auto _ : state) {
+        array.topK(1000, AreaKey{});
+        benchmark::DoNotOptimize(&array[0]);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// findIntersectingPairs - фигуры на сетке с шагом 20, соседи иногда перекрываются
+template <typename T>
+static void BM_IntersectingPairs(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T> array;
+    array.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        T x = static_cast<T>((i * 7919 % count) % 1000 * 20);
+        T y = static_cast<T>((i * 7919 % count) / 1000 * 20);
+        T s = static_cast<T>(5 + i % 19);
+        array.template emplace<Square<T>>(Point<T>(x, y), Point<T>(x + s, y), Point<T>(x + s, y + s), Point<T>(x, y + s));
+    }
+    size_t pairs = 0;
+    for (auto _ : state) {
+        pairs = findIntersectingPairs(array).size();
+        benchmark::DoNotOptimize(pairs);
+    }
+    state.counters["pairs"] = static_cast<double>(pairs);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// computeUnionArea на сетке: осевые квадраты вперемешку с треугольниками, соседи частично перекрываются
+template <typename T>
+static void BM_UnionArea(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T> array;
+    array.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        T x = static_cast<T>((i * 7919 % count) % 1000 * 20);
+        T y = static_cast<T>((i * 7919 % count) / 1000 * 20);
+        T s = static_cast<T>(5 + i % 19);
+        if (i % 2 == 0) {
+            array.template emplace<Square<T>>(Point<T>(x, y), Point<T>(x + s, y), Point<T>(x + s, y + s), Point<T>(x, y + s));
+        } else {
+            array.template emplace<Triangle<T>>(Point<T>(x, y), Point<T>(x + s, y), Point<T>(x, y + s));
+        }
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(computeUnionArea(array));
+    }
+    state.counters["overlap"] = array.computeTotalArea() - computeUnionArea(array);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// FigureArray::stats - опрос суммы площадей после небольшого изменения массива
+template <typename T>
+static void BM_StatsPoll(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T> array = makeArray<T>(count);
+    auto figure = std::make_shared<Square<T>>();
+    benchmark::DoNotOptimize(array.stats());
+    for (auto _ : state) {
+        array.eraseUnordered(count / 2);
+        array.add(figure);
+        benchmark::DoNotOptimize(array.stats().totalArea);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Добавление из нескольких потоков: FigureArray под общим мьютексом против ConcurrentFigureArray
+static constexpr size_t ingestThreads = 4;
+
+template <typename T>
+static void BM_MutexAdd(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    auto figures = makeFigures<T>(count);
+    for (auto _ : state) {
+        FigureArray<T> array;
+        std::mutex mutex;
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < ingestThreads; ++t) {
+            threads.emplace_back([&, t] {
+                for (size_t i = t; i < count; i += ingestThreads) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    array.add(figures[i]);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        benchmark::DoNotOptimize(array.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+template <typename T>
+static void BM_ConcurrentAdd(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    auto figures = makeFigures<T>(count);
+    for (auto _ : state) {
+        ConcurrentFigureArray<T> array;
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < ingestThreads; ++t) {
+            threads.emplace_back([&, t] {
+                for (size_t i = t; i < count; i += ingestThreads) {
+                    array.add(figures[i]);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        benchmark::DoNotOptimize(array.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+// Политики владения FigureArray: создание через emplace (включая перевыделения),
+// удаление из середины со сдвигом и суммирование площадей
+template <typename T, typename Ownership>
+static FigureArray<T, Ownership> makeOwnedArray(size_t count) {
+    FigureArray<T, Ownership> array;
+    for (size_t i = 0; i < count; ++i) {
+        T s = static_cast<T>(1 + i % 17);
+        array.template emplace<Square<T>>(Point<T>(0, 0), Point<T>(s, 0), Point<T>(s, s), Point<T>(0, s));
+    }
+    return array;
+}
+
+template <typename T, typename Ownership>
+static void BM_OwnershipEmplace(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        FigureArray<T, Ownership> array = makeOwnedArray<T, Ownership>(count);
+        benchmark::DoNotOptimize(array.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+template <typename T, typename Ownership>
+static void BM_OwnershipErase(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T, Ownership> array = makeOwnedArray<T, Ownership>(count);
+    for (auto _ : state) {
+        array.erase(count / 2);
+        array.template emplace<Square<T>>();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename T, typename Ownership>
+static void BM_OwnershipTotalArea(benchmark::State& state) {
+    size_t count = static_cast<size_t>(state.range(0));
+    FigureArray<T, Ownership> array = makeOwnedArray<T, Ownership>(count);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(array.computeTotalArea());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+}
+
+#define FIGURES_BENCHMARK(name)                                   \
+    BENCHMARK_TEMPLATE(name, int)->Apply(figureCounts);           \
+    BENCHMARK_TEMPLATE(name, float)->Apply(figureCounts);         \
+    BENCHMARK_TEMPLATE(name, double)->Apply(figureCounts)
+
+FIGURES_BENCHMARK(BM_Add);
+FIGURES_BENCHMARK(BM_EmplaceArena);
+FIGURES_BENCHMARK(BM_MakeSharedAdd);
+FIGURES_BENCHMARK(BM_Erase);
+FIGURES_BENCHMARK(BM_EraseUnordered);
+FIGURES_BENCHMARK(BM_EraseIf);
+FIGURES_BENCHMARK(BM_ComputeTotalArea);
+FIGURES_BENCHMARK(BM_ComputeTotalAreaParallel);
+FIGURES_BENCHMARK(BM_StatsPoll);
+FIGURES_BENCHMARK(BM_FigureStatistics);
+FIGURES_BENCHMARK(BM_SortByArea);
+FIGURES_BENCHMARK(BM_TopK);
+FIGURES_BENCHMARK(BM_IntersectingPairs);
+FIGURES_BENCHMARK(BM_UnionArea);
+FIGURES_BENCHMARK(BM_StaticComputeTotalArea);
+FIGURES_BENCHMARK(BM_IndexOperator);
+FIGURES_BENCHMARK(BM_FigureEquality);
+FIGURES_BENCHMARK(BM_CheckValidity);
+FIGURES_BENCHMARK(BM_BatchCheckValidity);
+FIGURES_BENCHMARK(BM_SpatialWindowQuery);
+FIGURES_BENCHMARK(BM_FindDuplicates);
+FIGURES_BENCHMARK(BM_BinaryRead);
+FIGURES_BENCHMARK(BM_BinaryReadColumns);
+FIGURES_BENCHMARK(BM_MappedTotalArea);
+FIGURES_BENCHMARK(BM_TextLoad);
+FIGURES_BENCHMARK(BM_ReportAreasCsv);
+FIGURES_BENCHMARK(BM_MutexAdd);
+FIGURES_BENCHMARK(BM_ConcurrentAdd);
+
+#define OWNERSHIP_BENCHMARK(name)                                                \
+    BENCHMARK_TEMPLATE(name, double, SharedOwnership)->Apply(figureCounts);      \
+    BENCHMARK_TEMPLATE(name, double, UniqueOwnership)->Apply(figureCounts);      \
+    BENCHMARK_TEMPLATE(name, double, IntrusiveOwnership)->Apply(figureCounts);   \
+    BENCHMARK_TEMPLATE(name, double, ValueOwnership)->Apply(figureCounts)
+
+OWNERSHIP_BENCHMARK(BM_OwnershipEmplace);
+OWNERSHIP_BENCHMARK(BM_OwnershipErase);
+OWNERSHIP_BENCHMARK(BM_OwnershipTotalArea);
+
+BENCHMARK_MAIN();
@@ -7,18 +7,127 @@
 #include <iomanip>
 #include <algorithm>
 #include <cassert>
+#include <array>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <memory_resource>
+#include <type_traits>
 #include "figure.h"
+#include "parallel.h"
+#include "canonical.h"
+#include "ownership.h"
+#include "ordering.h"
+
+// Вид арены для фигур, создаваемых через FigureArray::emplace
+// Monotonic подходит только для массивов, которые заполняются один раз и удаляются целиком:
+// при чередовании erase и emplace такая арена растёт без ограничения.
+enum class ArenaPolicy {
+    Monotonic,  // Память не возвращается до удаления массива, выделение - сдвиг указателя
+    Pool        // Память удалённых фигур переиспользуется
+};
    
-// Шаблонный класс FigureArray
-template <typename T>
+// Шаблонный класс FigureArray. Ownership - политика владения элементами (ownership.h):
+// SharedOwnership (по умолчанию), UniqueOwnership, IntrusiveOwnership или ValueOwnership.
+template <typename T, typename Ownership = SharedOwnership>
 class FigureArray {
+public:
+    using Handle = typename Ownership::template Handle<T>;
+
 private:
+    // Арена объявлена первой, чтобы разрушаться после фигур, размещённых в ней.
+    // Без _upstream арены нет, и emplace выделяет фигуры обычным образом.
+    std::pmr::memory_resource* _upstream;
+    ArenaPolicy _arenaPolicy;
+    std::unique_ptr<std::pmr::memory_resource> _arena;
     size_t _size;
     size_t _capacity;
-    std::unique_ptr<std::shared_ptr<Figure<T>>[]> _array;
+    std::unique_ptr<Handle[]> _array;
+
+    // Показатели для stats(), обновляемые за O(1) при каждом add и удалении.
+    // Для каждой стороны общего прямоугольника хранится число фигур, которые её касаются;
+    // прямоугольник пересчитывается при stats(), только если удалена последняя такая фигура.
+    struct RunningStats {
+        KahanSum area;
+        std::array<size_t, 3> kindCounts{};
+        BoundingBox<T> bounds;
+        std::array<size_t, 4> boundTouches{};  // minX, minY, maxX, maxY
+        bool boundsStale = false;
+    };
+    RunningStats _stats;
+
+    // Учёт стороны: lower - сторона минимума (новое значение меньше - граница сдвигается)
+    static void touchBound(T value, T& bound, size_t& touches, bool lower) {
+        if (value == bound) {
+            ++touches;
+        } else if (lower ? value < bound : value > bound) {
+            bound = value;
+            touches = 1;
+        }
+    }
+
+    void expandBounds(const BoundingBox<T>& box) {
+        touchBound(box.minX, _stats.bounds.minX, _stats.boundTouches[0], true);
+        touchBound(box.minY, _stats.bounds.minY, _stats.boundTouches[1], true);
+        touchBound(box.maxX, _stats.bounds.maxX, _stats.boundTouches[2], false);
+        touchBound(box.maxY, _stats.bounds.maxY, _stats.boundTouches[3], false);
+    }
+
+    // Учёт новой фигуры; count - число учтённых фигур вместе с ней
+    void account(const Figure<T>& figure, size_t count) {
+        _stats.area.add(static_cast<double>(figure));
+        ++_stats.kindCounts[static_cast<size_t>(figure.kind())];
+        if (_stats.boundsStale) return;  // Прямоугольник всё равно будет пересчитан в stats()
+        BoundingBox<T> box = figure.boundingBox();
+        if (count == 1) {
+            _stats.bounds = box;
+            _stats.boundTouches = {1, 1, 1, 1};
+        } else {
+            expandBounds(box);
+        }
+    }
+
+    // Вычитание вклада удаляемой фигуры; count - число учтённых фигур вместе с ней
+    void forget(const Figure<T>& figure, size_t count) {
+        if (count == 1) {
+            _stats = RunningStats();
+            return;
+        }
+        _stats.area.add(-static_cast<double>(figure));
+        --_stats.kindCounts[static_cast<size_t>(figure.kind())];
+        if (_stats.boundsStale) return;
+        BoundingBox<T> box = figure.boundingBox();
+        T values[4] = {box.minX, box.minY, box.maxX, box.maxY};
+        T bounds[4] = {_stats.bounds.minX, _stats.bounds.minY, _stats.bounds.maxX, _stats.bounds.maxY};
+        for (size_t side = 0; side < 4; ++side) {
+            if (values[side] == bounds[side] && --_stats.boundTouches[side] == 0) {
+                _stats.boundsStale = true;
+            }
+        }
+    }
+
+    // Размер фрагмента для параллельных проходов. Фрагменты не зависят от числа
+    // потоков, поэтому и результат параллельных агрегатов от него не зависит.
+    static constexpr size_t parallelChunkSize = 4096;
+
+    size_t chunkCount() const {
+        return (_size + parallelChunkSize - 1) / parallelChunkSize;
+    }
+
+    std::pmr::memory_resource* arena() {
+        if (!_upstream) return nullptr;
+        if (!_arena) {
+            if (_arenaPolicy == ArenaPolicy::Pool) {
+                _arena = std::make_unique<std::pmr::unsynchronized_pool_resource>(_upstream);
+            } else {
+                _arena = std::make_unique<std::pmr::monotonic_buffer_resource>(64 * 1024, _upstream);
+            }
+        }
+        return _arena.get();
+    }
 
     void reallocate(size_t newCapacity) {
-        auto newArray = std::make_unique<std::shared_ptr<Figure<T>>[]>(newCapacity);
+        auto newArray = std::make_unique<Handle[]>(newCapacity);
         for (size_t i = 0; i < _size; ++i) {
             newArray[i] = std::move(_array[i]);
         }
@@ -27,8 +136,18 @@ private:
     }
 
 public:
-    FigureArray() : _size(0), _capacity(4) {
-        _array = std::make_unique<std::shared_ptr<Figure<T>>[]>(_capacity);
+    FigureArray()
+        : _upstream(nullptr), _arenaPolicy(ArenaPolicy::Pool),
+          _size(0), _capacity(4) {
+        _array = std::make_unique<Handle[]>(_capacity);
+    }
+
+    // Массив с ареной для emplace поверх заданного ресурса памяти
+    explicit FigureArray(std::pmr::memory_resource* upstream,
+                         ArenaPolicy policy = ArenaPolicy::Pool)
+        : _upstream(upstream ? upstream : std::pmr::get_default_resource()), _arenaPolicy(policy),
+          _size(0), _capacity(4) {
+        _array = std::make_unique<Handle[]>(_capacity);
     }
 
     // Конструктор копирования - УДАЛЕН, т.к. unique_ptr нельзя копировать
@@ -36,9 +155,12 @@ public:
 
     // Конструктор перемещения
     FigureArray(FigureArray&& other) noexcept 
-        : _size(other._size), _capacity(other._capacity), _array(std::move(other._array)) {
+        : _upstream(other._upstream), _arenaPolicy(other._arenaPolicy), _arena(std::move(other._arena)),
+          _size(other._size), _capacity(other._capacity), _array(std::move(other._array)),
+          _stats(other._stats) {
         other._size = 0;
         other._capacity = 0;
+        other._stats = RunningStats();
     }
 
     // Оператор присваивания копированием - УДАЛЕН
@@ -49,19 +171,46 @@ public:
         if (this != &other) {
             _size = other._size;
             _capacity = other._capacity;
+            // Сначала освобождаются старые фигуры, затем арена, в которой они могли лежать
             _array = std::move(other._array);
+            _arena = std::move(other._arena);
+            _upstream = other._upstream;
+            _arenaPolicy = other._arenaPolicy;
+            _stats = other._stats;
             other._size = 0;
             other._capacity = 0;
+            other._stats = RunningStats();
         }
         return *this;
     }
 
-    // Добавление через shared_ptr
-    void add(std::shared_ptr<Figure<T>> figure) {
+    // Резервирование места под capacity фигур без перевыделений при последующих add
+    void reserve(size_t capacity) {
+        if (capacity > _capacity) {
+            reallocate(capacity);
+        }
+    }
+
+    // Добавление дескриптора политики владения (для SharedOwnership - shared_ptr)
+    void add(Handle figure) {
         if (_size >= _capacity) {
-            reallocate(_capacity * 2);
+            reallocate(std::max<size_t>(4, _capacity * 2));
         }
         _array[_size++] = std::move(figure);
+        account(*_array[_size - 1], _size);
+    }
+
+    // Создание фигуры на месте. Для SharedOwnership фигура и блок управления shared_ptr
+    // размещаются одним выделением: из арены массива, если она задана в конструкторе, иначе через make_shared.
+    // Для ValueOwnership ссылка действительна до следующего перевыделения или удаления.
+    // Изменение фигуры через эту ссылку или operator[] требует invalidateStats().
+    template <typename Kind, typename... Args>
+    Kind& emplace(Args&&... args) {
+        static_assert(std::is_base_of_v<Figure<T>, Kind>, "Kind must derive from Figure<T>");
+        std::pmr::memory_resource* resource = nullptr;
+        if constexpr (Ownership::usesArena) resource = arena();
+        add(Ownership::template make<T, Kind>(resource, std::forward<Args>(args)...));
+        return static_cast<Kind&>(*_array[_size - 1]);
     }
 
     // Операторы доступа
@@ -77,29 +226,174 @@ public:
 
     void erase(size_t index) {
         if (index >= _size) throw std::out_of_range("Index invalid");
-        
+        forget(*_array[index], _size);
+
         for (size_t i = index + 1; i < _size; ++i) {
             _array[i - 1] = std::move(_array[i]);
         }
         _array[--_size].reset();
     }
 
+    // Удаление без сохранения порядка: на место удалённого элемента переносится последний, O(1)
+    void eraseUnordered(size_t index) {
+        if (index >= _size) throw std::out_of_range("Index invalid");
+        forget(*_array[index], _size);
+
+        --_size;
+        if (index != _size) {
+            _array[index] = std::move(_array[_size]);
+        }
+        _array[_size].reset();
+    }
+
+    // Удаление всех фигур, удовлетворяющих предикату, за один проход с сохранением порядка.
+    // Возвращает число удалённых фигур.
+    template <typename Predicate>
+    size_t eraseIf(Predicate predicate) {
+        size_t kept = 0;
+        size_t remaining = _size;
+        for (size_t i = 0; i < _size; ++i) {
+            if (predicate(static_cast<const Figure<T>&>(*_array[i]))) {
+                forget(*_array[i], remaining--);
+                continue;
+            }
+            if (kept != i) {
+                _array[kept] = std::move(_array[i]);
+            }
+            ++kept;
+        }
+
+        size_t removed = _size - kept;
+        for (size_t i = kept; i < _size; ++i) {
+            _array[i].reset();
+        }
+        _size = kept;
+        return removed;
+    }
+
     size_t size() const { return _size; }
 
+    // Сводные показатели: число фигур по видам, сумма площадей и общий ограничивающий прямоугольник.
+    // Поддерживаются за O(1) при add, emplace и удалениях; опрос - O(1), кроме пересчёта прямоугольника
+    // после удаления последней фигуры, касавшейся его стороны. Метод не константный из-за этого
+    // пересчёта и, как другие изменяющие методы, не синхронизирован.
+    // Фигуры, изменённые на месте после добавления (через operator[] или ссылку из emplace),
+    // требуют invalidateStats().
+    FigureArrayStats<T> stats() {
+        if (_stats.boundsStale) {
+            _stats.boundsStale = false;
+            for (size_t i = 0; i < _size; ++i) {
+                BoundingBox<T> box = _array[i]->boundingBox();
+                if (i == 0) {
+                    _stats.bounds = box;
+                    _stats.boundTouches = {1, 1, 1, 1};
+                } else {
+                    expandBounds(box);
+                }
+            }
+        }
+
+        FigureArrayStats<T> result;
+        result.count = _size;
+        result.kindCounts = _stats.kindCounts;
+        result.totalArea = _stats.area.result();
+        result.bounds = _stats.bounds;
+        return result;
+    }
+
+    // Полный пересчёт показателей, O(n)
+    void invalidateStats() {
+        _stats = RunningStats();
+        for (size_t i = 0; i < _size; ++i) {
+            account(*_array[i], i + 1);
+        }
+    }
+
+    // Упорядочивание по ключу (ordering.h): ключи вычисляются один раз параллельно, затем
+    // сортируется массив пар (ключ, индекс) без виртуальных вызовов, и ячейки переставляются на месте.
+    // Равные ключи сохраняют исходный порядок; фигуры с ключом NaN оказываются в конце.
+    template <typename Key>
+    void sortBy(Key key, SortOrder order = SortOrder::Ascending, ThreadPool& pool = defaultThreadPool()) {
+        std::vector<ordering_detail::KeyedIndex> entries = computeKeys(key, order, pool);
+        parallelSort(entries, ordering_detail::keyedLess, pool);
+        permute(entries);
+    }
+
+    // k фигур с наибольшими ключами в начало массива по убыванию ключа; остальные - следом
+    // в исходном порядке. Отбор кандидатов выполняется параллельно по блокам.
+    template <typename Key>
+    void topK(size_t k, Key key, ThreadPool& pool = defaultThreadPool()) {
+        k = std::min(k, _size);
+        if (k == 0) return;
+        permute(ordering_detail::topKOrder(computeKeys(key, SortOrder::Descending, pool), k, pool));
+    }
+
+    // Фигура с рангом n по ключу - на позицию n; до неё фигуры с не большими ключами, после - с не меньшими.
+    // Ключи считаются параллельно, выбор (std::nth_element по массиву ключей) - последовательно, O(n).
+    template <typename Key>
+    void nthElement(size_t n, Key key, SortOrder order = SortOrder::Ascending, ThreadPool& pool = defaultThreadPool()) {
+        if (n >= _size) throw std::out_of_range("Index out of bounds");
+        std::vector<ordering_detail::KeyedIndex> entries = computeKeys(key, order, pool);
+        std::nth_element(entries.begin(), entries.begin() + static_cast<std::ptrdiff_t>(n), entries.end(),
+                         ordering_detail::keyedLess);
+        permute(entries);
+    }
+
+private:
+    template <typename Key>
+    std::vector<ordering_detail::KeyedIndex> computeKeys(Key& key, SortOrder order, ThreadPool& pool) const {
+        return ordering_detail::computeKeys(_size, parallelChunkSize, [&](size_t i) {
+            return key(static_cast<const Figure<T>&>(*_array[i]));
+        }, order, pool);
+    }
+
+    // Перестановка ячеек; показатели stats() от порядка не зависят
+    void permute(const std::vector<ordering_detail::KeyedIndex>& order) {
+        ordering_detail::applyPermutation(_array.get(), order);
+    }
+
+public:
+    // Группы равных (по operator==) фигур из двух и более элементов: индексы по возрастанию,
+    // группы - по первому индексу. Поиск через хеш канонических форм, ожидаемое время O(n).
+    std::vector<std::vector<size_t>> findDuplicates(double quantum = canonicalQuantum) const {
+        return duplicateGroups(groupEqualFigures(_size, [this](size_t i) -> const Figure<T>& { return *_array[i]; }, quantum));
+    }
+
+    // Удаление повторов: остаётся первое вхождение каждой фигуры, порядок сохраняется.
+    // Возвращает число удалённых фигур.
+    size_t dedup(double quantum = canonicalQuantum) {
+        std::vector<size_t> group = groupEqualFigures(_size, [this](size_t i) -> const Figure<T>& { return *_array[i]; }, quantum);
+        size_t position = 0;
+        return eraseIf([&](const Figure<T>&) {
+            size_t i = position++;
+            return group[i] != i;
+        });
+    }
+
+    // Включение кэша площади, центроида и ограничивающего прямоугольника у всех фигур.
+    // Фигура, добавленная в массив несколько раз, не должна читаться параллельными агрегатами при включённом кэше.
+    void setCaching(bool enabled) {
+        for (size_t i = 0; i < _size; ++i) {
+            _array[i]->setCaching(enabled);
+        }
+    }
+
     void displayAreas() const {
         std::cout << std::fixed << std::setprecision(2);
         for (size_t i = 0; i < _size; ++i) {
             std::cout << i << ": " << *_array[i]
-                      << " | Area = " << static_cast<double>(*_array[i]) << std::endl;
+                      << " | Area = " << static_cast<double>(*_array[i]) << '\n';
         }
+        std::cout.flush();
     }
 
     void displayCentroids() const {
         for (size_t i = 0; i < _size; ++i) {
-            Point<T> centroid = _array[i]->getCentroid();
+            Point<T> centroid = _array[i]->centroid();
             std::cout << i << ": Centroid = (" << centroid.getX() 
-                      << ", " << centroid.getY() << ")" << std::endl;
+                      << ", " << centroid.getY() << ")" << '\n';
         }
+        std::cout.flush();
     }
 
     double computeTotalArea() const {
@@ -109,6 +403,82 @@ public:
         }
         return total;
     }
+
+    // Параллельные версии агрегатов
+    double computeTotalAreaParallel(ThreadPool& pool = defaultThreadPool()) const {
+        std::vector<double> partial(chunkCount());
+        pool.parallelFor(partial.size(), [&](size_t chunk) {
+            size_t end = std::min(_size, (chunk + 1) * parallelChunkSize);
+            KahanSum sum;
+            for (size_t i = chunk * parallelChunkSize; i < end; ++i) {
+                sum.add(static_cast<double>(*_array[i]));
+            }
+            partial[chunk] = sum.result();
+        });
+        return pairwiseSum(partial.data(), partial.size());
+    }
+
+    std::vector<double> computeAreasParallel(ThreadPool& pool = defaultThreadPool()) const {
+        std::vector<double> areas(_size);
+        pool.parallelFor(chunkCount(), [&](size_t chunk) {
+            size_t end = std::min(_size, (chunk + 1) * parallelChunkSize);
+            for (size_t i = chunk * parallelChunkSize; i < end; ++i) {
+                areas[i] = static_cast<double>(*_array[i]);
+            }
+        });
+        return areas;
+    }
+
+    std::vector<Point<T>> computeCentroidsParallel(ThreadPool& pool = defaultThreadPool()) const {
+        std::vector<Point<T>> centroids(_size);
+        pool.parallelFor(chunkCount(), [&](size_t chunk) {
+            size_t end = std::min(_size, (chunk + 1) * parallelChunkSize);
+            for (size_t i = chunk * parallelChunkSize; i < end; ++i) {
+                centroids[i] = _array[i]->centroid();
+            }
+        });
+        return centroids;
+    }
+
+    // Строки формируются параллельно по фрагментам, вывод - последовательно в исходном порядке
+    void displayAreasParallel(ThreadPool& pool = defaultThreadPool()) const {
+        std::vector<std::string> lines(chunkCount());
+        pool.parallelFor(lines.size(), [&](size_t chunk) {
+            std::ostringstream os;
+            os << std::fixed << std::setprecision(2);
+            size_t end = std::min(_size, (chunk + 1) * parallelChunkSize);
+            for (size_t i = chunk * parallelChunkSize; i < end; ++i) {
+                os << i << ": " << *_array[i]
+                   << " | Area = " << static_cast<double>(*_array[i]) << '\n';
+            }
+            lines[chunk] = os.str();
+        });
+        std::cout << std::fixed << std::setprecision(2);
+        for (const auto& text : lines) {
+            std::cout << text;
+        }
+        std::cout.flush();
+    }
+
+    void displayCentroidsParallel(ThreadPool& pool = defaultThreadPool()) const {
+        std::vector<std::string> lines(chunkCount());
+        pool.parallelFor(lines.size(), [&](size_t chunk) {
+            std::ostringstream os;
+            os.flags(std::cout.flags());
+            os.precision(std::cout.precision());
+            size_t end = std::min(_size, (chunk + 1) * parallelChunkSize);
+            for (size_t i = chunk * parallelChunkSize; i < end; ++i) {
+                Point<T> centroid = _array[i]->centroid();
+                os << i << ": Centroid = (" << centroid.getX()
+                   << ", " << centroid.getY() << ")" << '\n';
+            }
+            lines[chunk] = os.str();
+        });
+        for (const auto& text : lines) {
+            std::cout << text;
+        }
+        std::cout.flush();
+    }
 }; 
 
 #endif
\ No newline at end of file
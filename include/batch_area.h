@@ -0,0 +1,235 @@
+#ifndef BATCH_AREA_H
+#define BATCH_AREA_H
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include "simd.h"
+#include "column_store.h"
+
+// Пакетное вычисление площадей по формуле шнурования (через векторные произведения).
+//
+// Формат упакованных координат: все фигуры пакета имеют одинаковое число вершин,
+// координата вершины v фигуры i лежит в xs[v * count + i] и ys[v * count + i].
+// Такое расположение позволяет загружать одну вершину сразу у 2-16 фигур одной инструкцией.
+//
+// Для корректных фигур результат совпадает с calculateArea() соответствующего класса.
+// Все пути выполняют одни и те же операции в одном порядке (без FMA), поэтому
+// результаты не зависят от выбранного уровня SIMD.
+
+namespace batch_area_detail {
+
+template <typename U>
+inline void shoelaceScalar(const U* xs, const U* ys, size_t vertices, size_t count,
+                           size_t begin, U* areas) {
+    for (size_t i = begin; i < count; ++i) {
+        U x0 = xs[i];
+        U y0 = ys[i];
+        U px = xs[count + i] - x0;
+        U py = ys[count + i] - y0;
+        U sum = U(0);
+        for (size_t v = 2; v < vertices; ++v) {
+            U cx = xs[v * count + i] - x0;
+            U cy = ys[v * count + i] - y0;
+            sum = sum + (px * cy - cx * py);
+            px = cx;
+            py = cy;
+        }
+        areas[i] = std::abs(sum) * U(0.5);
+    }
+}
+
+#if FIGURES_SIMD_X86
+
+__attribute__((target("sse2")))
+inline void shoelaceSse2(const double* xs, const double* ys, size_t vertices, size_t count, double* areas) {
+    const __m128d half = _mm_set1_pd(0.5);
+    const __m128d signMask = _mm_set1_pd(-0.0);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128d x0 = _mm_loadu_pd(xs + i);
+        __m128d y0 = _mm_loadu_pd(ys + i);
+        __m128d px = _mm_sub_pd(_mm_loadu_pd(xs + count + i), x0);
+        __m128d py = _mm_sub_pd(_mm_loadu_pd(ys + count + i), y0);
+        __m128d sum = _mm_setzero_pd();
+        for (size_t v = 2; v < vertices; ++v) {
+            __m128d cx = _mm_sub_pd(_mm_loadu_pd(xs + v * count + i), x0);
+            __m128d cy = _mm_sub_pd(_mm_loadu_pd(ys + v * count + i), y0);
+            sum = _mm_add_pd(sum, _mm_sub_pd(_mm_mul_pd(px, cy), _mm_mul_pd(cx, py)));
+            px = cx;
+            py = cy;
+        }
+        _mm_storeu_pd(areas + i, _mm_mul_pd(_mm_andnot_pd(signMask, sum), half));
+    }
+    shoelaceScalar(xs, ys, vertices, count, i, areas);
+}
+
+__attribute__((target("sse2")))
+inline void shoelaceSse2(const float* xs, const float* ys, size_t vertices, size_t count, float* areas) {
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 x0 = _mm_loadu_ps(xs + i);
+        __m128 y0 = _mm_loadu_ps(ys + i);
+        __m128 px = _mm_sub_ps(_mm_loadu_ps(xs + count + i), x0);
+        __m128 py = _mm_sub_ps(_mm_loadu_ps(ys + count + i), y0);
+        __m128 sum = _mm_setzero_ps();
+        for (size_t v = 2; v < vertices; ++v) {
+            __m128 cx = _mm_sub_ps(_mm_loadu_ps(xs + v * count + i), x0);
+            __m128 cy = _mm_sub_ps(_mm_loadu_ps(ys + v * count + i), y0);
+            sum = _mm_add_ps(sum, _mm_sub_ps(_mm_mul_ps(px, cy), _mm_mul_ps(cx, py)));
+            px = cx;
+            py = cy;
+        }
+        _mm_storeu_ps(areas + i, _mm_mul_ps(_mm_andnot_ps(signMask, sum), half));
+    }
+    shoelaceScalar(xs, ys, vertices, count, i, areas);
+}
+
+__attribute__((target("avx2")))
+inline void shoelaceAvx2(const double* xs, const double* ys, size_t vertices, size_t count, double* areas) {
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d x0 = _mm256_loadu_pd(xs + i);
+        __m256d y0 = _mm256_loadu_pd(ys + i);
+        __m256d px = _mm256_sub_pd(_mm256_loadu_pd(xs + count + i), x0);
+        __m256d py = _mm256_sub_pd(_mm256_loadu_pd(ys + count + i), y0);
+        __m256d sum = _mm256_setzero_pd();
+        for (size_t v = 2; v < vertices; ++v) {
+            __m256d cx = _mm256_sub_pd(_mm256_loadu_pd(xs + v * count + i), x0);
+            __m256d cy = _mm256_sub_pd(_mm256_loadu_pd(ys + v * count + i), y0);
+            sum = _mm256_add_pd(sum, _mm256_sub_pd(_mm256_mul_pd(px, cy), _mm256_mul_pd(cx, py)));
+            px = cx;
+            py = cy;
+        }
+        _mm256_storeu_pd(areas + i, _mm256_mul_pd(_mm256_andnot_pd(signMask, sum), half));
+    }
+    shoelaceScalar(xs, ys, vertices, count, i, areas);
+}
+
+__attribute__((target("avx2")))
+inline void shoelaceAvx2(const float* xs, const float* ys, size_t vertices, size_t count, float* areas) {
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 x0 = _mm256_loadu_ps(xs + i);
+        __m256 y0 = _mm256_loadu_ps(ys + i);
+        __m256 px = _mm256_sub_ps(_mm256_loadu_ps(xs + count + i), x0);
+        __m256 py = _mm256_sub_ps(_mm256_loadu_ps(ys + count + i), y0);
+        __m256 sum = _mm256_setzero_ps();
+        for (size_t v = 2; v < vertices; ++v) {
+            __m256 cx = _mm256_sub_ps(_mm256_loadu_ps(xs + v * count + i), x0);
+            __m256 cy = _mm256_sub_ps(_mm256_loadu_ps(ys + v * count + i), y0);
+            sum = _mm256_add_ps(sum, _mm256_sub_ps(_mm256_mul_ps(px, cy), _mm256_mul_ps(cx, py)));
+            px = cx;
+            py = cy;
+        }
+        _mm256_storeu_ps(areas + i, _mm256_mul_ps(_mm256_andnot_ps(signMask, sum), half));
+    }
+    shoelaceScalar(xs, ys, vertices, count, i, areas);
+}
+
+__attribute__((target("avx512f")))
+inline void shoelaceAvx512(const double* xs, const double* ys, size_t vertices, size_t count, double* areas) {
+    const __m512d half = _mm512_set1_pd(0.5);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512d x0 = _mm512_loadu_pd(xs + i);
+        __m512d y0 = _mm512_loadu_pd(ys + i);
+        __m512d px = _mm512_sub_pd(_mm512_loadu_pd(xs + count + i), x0);
+        __m512d py = _mm512_sub_pd(_mm512_loadu_pd(ys + count + i), y0);
+        __m512d sum = _mm512_setzero_pd();
+        for (size_t v = 2; v < vertices; ++v) {
+            __m512d cx = _mm512_sub_pd(_mm512_loadu_pd(xs + v * count + i), x0);
+            __m512d cy = _mm512_sub_pd(_mm512_loadu_pd(ys + v * count + i), y0);
+            sum = _mm512_add_pd(sum, _mm512_sub_pd(_mm512_mul_pd(px, cy), _mm512_mul_pd(cx, py)));
+            px = cx;
+            py = cy;
+        }
+        _mm512_storeu_pd(areas + i, _mm512_mul_pd(_mm512_abs_pd(sum), half));
+    }
+    shoelaceScalar(xs, ys, vertices, count, i, areas);
+}
+
+__attribute__((target("avx512f")))
+inline void shoelaceAvx512(const float* xs, const float* ys, size_t vertices, size_t count, float* areas) {
+    const __m512 half = _mm512_set1_ps(0.5f);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512 x0 = _mm512_loadu_ps(xs + i);
+        __m512 y0 = _mm512_loadu_ps(ys + i);
+        __m512 px = _mm512_sub_ps(_mm512_loadu_ps(xs + count + i), x0);
+        __m512 py = _mm512_sub_ps(_mm512_loadu_ps(ys + count + i), y0);
+        __m512 sum = _mm512_setzero_ps();
+        for (size_t v = 2; v < vertices; ++v) {
+            __m512 cx = _mm512_sub_ps(_mm512_loadu_ps(xs + v * count + i), x0);
+            __m512 cy = _mm512_sub_ps(_mm512_loadu_ps(ys + v * count + i), y0);
+            sum = _mm512_add_ps(sum, _mm512_sub_ps(_mm512_mul_ps(px, cy), _mm512_mul_ps(cx, py)));
+            px = cx;
+            py = cy;
+        }
+        _mm512_storeu_ps(areas + i, _mm512_mul_ps(_mm512_abs_ps(sum), half));
+    }
+    shoelaceScalar(xs, ys, vertices, count, i, areas);
+}
+
+#endif
+
+} // namespace batch_area_detail
+
+// Площади count фигур с vertices вершинами в упакованном формате.
+// Уровень SIMD по умолчанию определяется во время выполнения; более высокий уровень,
+// чем поддерживает процессор, понижается до доступного.
+template <typename U>
+    requires std::is_same_v<U, float> || std::is_same_v<U, double>
+void batchShoelaceArea(const U* xs, const U* ys, size_t vertices, size_t count, U* areas,
+                       SimdLevel level = detectSimdLevel()) {
+    if (vertices < 3) throw std::invalid_argument("Figure must have at least 3 vertices");
+
+    switch (clampSimdLevel(level)) {
+#if FIGURES_SIMD_X86
+        case SimdLevel::AVX512:
+            batch_area_detail::shoelaceAvx512(xs, ys, vertices, count, areas);
+            return;
+        case SimdLevel::AVX2:
+            batch_area_detail::shoelaceAvx2(xs, ys, vertices, count, areas);
+            return;
+        case SimdLevel::SSE2:
+            batch_area_detail::shoelaceSse2(xs, ys, vertices, count, areas);
+            return;
+#endif
+        default:
+            batch_area_detail::shoelaceScalar(xs, ys, vertices, count, 0, areas);
+            return;
+    }
+}
+
+// Площади всех фигур колоночного хранилища: фигуры упаковываются по видам и
+// обрабатываются пакетным ядром. Для T = float используется ядро одинарной точности.
+template <typename T>
+void computeAreasBatch(const FigureColumnStore<T>& store, std::vector<double>& areas,
+                       SimdLevel level = detectSimdLevel()) {
+    using Lane = std::conditional_t<std::is_same_v<T, float>, float, double>;
+
+    areas.assign(store.size(), 0.0);
+    std::vector<Lane> xs, ys, packedAreas;
+    std::vector<size_t> indices;
+    for (FigureKind kind : {FigureKind::Triangle, FigureKind::Square, FigureKind::Rectangle}) {
+        size_t vertices = store.packKind(kind, xs, ys, indices);
+        if (indices.empty()) continue;
+
+        packedAreas.resize(indices.size());
+        batchShoelaceArea(xs.data(), ys.data(), vertices, indices.size(), packedAreas.data(), level);
+        for (size_t j = 0; j < indices.size(); ++j) {
+            areas[indices[j]] = packedAreas[j];
+        }
+    }
+}
+
+#endif
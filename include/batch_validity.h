@@ -0,0 +1,404 @@
+#ifndef BATCH_VALIDITY_H
+#define BATCH_VALIDITY_H
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include "simd.h"
+#include "exact.h"
+#include "column_store.h"
+
+// Пакетная проверка валидности фигур в упакованном формате batch_area.h
+// (координата вершины v фигуры i - xs[v * count + i], ys[v * count + i]).
+//
+// Для вещественных координат проверяются те же ограничения, что и в checkValidity() классов фигур,
+// в том же порядке:
+//   1. все вершины различны (|dx| < EPS и |dy| < EPS - совпадение);
+//   2. треугольник: площадь > EPS; квадрат: все стороны равны; прямоугольник: противоположные равны;
+//   3. квадрат и прямоугольник: |скалярное произведение сторон при вершине 0| < EPS.
+// Стороны сравниваются по квадратам длин без sqrt: для a = sqrt(A), b = sqrt(B)
+//   |a - b| > E  <=>  A + B > E^2  и  (A - B)^2 > E^2 * (2(A + B) - E^2).
+// Разность A - B вычисляется до возведения в квадрат, поэтому на больших сторонах
+// (порядка 1e4-1e6) сравнение не теряет точность, в отличие от (A + B - E^2)^2 против 4AB.
+// Площадь треугольника считается через векторное произведение, а не по формуле Герона,
+// поэтому на самой границе EPS результат может отличаться от checkValidity() из-за округления.
+// Все пути выполняют одни и те же операции (без FMA), результаты не зависят от уровня SIMD.
+// Для целых координат checkValidityBatch, как и checkValidity(), использует точные предикаты exact.h
+// (скалярно, без EPS); упакованные функции для double к ним не применяются.
+
+// Причина невалидности фигуры
+enum class ValidityReason : unsigned char {
+    Valid,
+    DuplicateVertex,  // Совпадающие вершины
+    Degenerate,       // Треугольник нулевой площади
+    UnequalSides,     // Стороны квадрата (противоположные стороны прямоугольника) не равны
+    NotRightAngle     // Угол при вершине 0 не прямой
+};
+
+inline const char* validityReasonName(ValidityReason reason) {
+    switch (reason) {
+        case ValidityReason::Valid: return "valid";
+        case ValidityReason::DuplicateVertex: return "duplicate vertex";
+        case ValidityReason::Degenerate: return "degenerate";
+        case ValidityReason::UnequalSides: return "unequal sides";
+        case ValidityReason::NotRightAngle: return "not a right angle";
+    }
+    return "unknown";
+}
+
+namespace batch_validity_detail {
+
+inline ValidityReason shapeReason(FigureKind kind) {
+    return kind == FigureKind::Triangle ? ValidityReason::Degenerate : ValidityReason::UnequalSides;
+}
+
+// Причина по битам масок одной фигуры
+inline ValidityReason combine(bool duplicate, bool badShape, bool badAngle, FigureKind kind) {
+    if (duplicate) return ValidityReason::DuplicateVertex;
+    if (badShape) return shapeReason(kind);
+    if (badAngle) return ValidityReason::NotRightAngle;
+    return ValidityReason::Valid;
+}
+
+// Точная причина для целых координат; порядок проверок тот же
+template <std::integral T>
+ValidityReason exactReason(FigureKind kind, const Point<T>* points) {
+    using exact_detail::squaredLength;
+    if (!exactDistinct(points, kind == FigureKind::Triangle ? 3 : 4)) return ValidityReason::DuplicateVertex;
+    if (kind == FigureKind::Triangle) {
+        return exactTwiceArea(points, 3) != 0 ? ValidityReason::Valid : ValidityReason::Degenerate;
+    }
+    bool sidesEqual = kind == FigureKind::Square
+        ? squaredLength(points[0], points[1]) == squaredLength(points[1], points[2]) &&
+          squaredLength(points[1], points[2]) == squaredLength(points[2], points[3]) &&
+          squaredLength(points[2], points[3]) == squaredLength(points[3], points[0])
+        : squaredLength(points[0], points[1]) == squaredLength(points[2], points[3]) &&
+          squaredLength(points[1], points[2]) == squaredLength(points[3], points[0]);
+    if (!sidesEqual) return ValidityReason::UnequalSides;
+    return exactRightAngle(points) ? ValidityReason::Valid : ValidityReason::NotRightAngle;
+}
+
+// Таблица причин по индексу duplicate | badShape << 1 | badAngle << 2 (без ветвлений в векторных путях)
+struct ReasonTable {
+    ValidityReason reasons[8];
+
+    explicit ReasonTable(FigureKind kind) {
+        for (unsigned bits = 0; bits < 8; ++bits) {
+            reasons[bits] = combine(bits & 1, bits & 2, bits & 4, kind);
+        }
+    }
+};
+
+// Запись причин для lanes фигур по маскам movemask
+inline void storeReasons(const ReasonTable& table, int duplicate, int badShape, int badAngle,
+                         int lanes, ValidityReason* reasons) {
+    for (int lane = 0; lane < lanes; ++lane) {
+        unsigned bits = ((duplicate >> lane) & 1) | (((badShape >> lane) & 1) << 1) | (((badAngle >> lane) & 1) << 2);
+        reasons[lane] = table.reasons[bits];
+    }
+}
+
+// Стороны с квадратами длин a и b различаются больше чем на EPS
+inline bool sidesDiffer(double a, double b) {
+    double sum = a + b;
+    double difference = a - b;
+    return sum > EPS * EPS && difference * difference > EPS * EPS * (2 * sum - EPS * EPS);
+}
+
+inline double squaredSide(const double* xs, const double* ys, size_t count, size_t i, size_t from, size_t to) {
+    double dx = xs[to * count + i] - xs[from * count + i];
+    double dy = ys[to * count + i] - ys[from * count + i];
+    return dx * dx + dy * dy;
+}
+
+inline void validityScalar(FigureKind kind, const double* xs, const double* ys, size_t count,
+                           size_t begin, ValidityReason* reasons) {
+    size_t vertices = kind == FigureKind::Triangle ? 3 : 4;
+    for (size_t i = begin; i < count; ++i) {
+        bool duplicate = false;
+        for (size_t a = 0; a < vertices; ++a) {
+            for (size_t b = a + 1; b < vertices; ++b) {
+                double dx = std::abs(xs[b * count + i] - xs[a * count + i]);
+                double dy = std::abs(ys[b * count + i] - ys[a * count + i]);
+                duplicate |= dx < EPS && dy < EPS;
+            }
+        }
+
+        double ux = xs[count + i] - xs[i];
+        double uy = ys[count + i] - ys[i];
+        bool badShape;
+        bool badAngle = false;
+        if (kind == FigureKind::Triangle) {
+            double wx = xs[2 * count + i] - xs[i];
+            double wy = ys[2 * count + i] - ys[i];
+            double area = std::abs(ux * wy - wx * uy) * 0.5;
+            badShape = !(area > EPS);
+        } else {
+            double s0 = squaredSide(xs, ys, count, i, 0, 1);
+            double s1 = squaredSide(xs, ys, count, i, 1, 2);
+            double s2 = squaredSide(xs, ys, count, i, 2, 3);
+            double s3 = squaredSide(xs, ys, count, i, 3, 0);
+            if (kind == FigureKind::Square) {
+                badShape = sidesDiffer(s0, s1) || sidesDiffer(s1, s2) || sidesDiffer(s2, s3);
+            } else {
+                badShape = sidesDiffer(s0, s2) || sidesDiffer(s1, s3);
+            }
+            double wx = xs[3 * count + i] - xs[i];
+            double wy = ys[3 * count + i] - ys[i];
+            badAngle = !(std::abs(ux * wx + uy * wy) < EPS);
+        }
+        reasons[i] = combine(duplicate, badShape, badAngle, kind);
+    }
+}
+
+#if FIGURES_SIMD_X86
+
+__attribute__((target("sse2")))
+inline __m128d sidesDifferSse2(__m128d a, __m128d b) {
+    const __m128d e2 = _mm_set1_pd(EPS * EPS);
+    __m128d sum = _mm_add_pd(a, b);
+    __m128d difference = _mm_sub_pd(a, b);
+    __m128d bound = _mm_mul_pd(e2, _mm_sub_pd(_mm_mul_pd(_mm_set1_pd(2.0), sum), e2));
+    return _mm_and_pd(_mm_cmpgt_pd(sum, e2), _mm_cmpgt_pd(_mm_mul_pd(difference, difference), bound));
+}
+
+template <FigureKind kind>
+__attribute__((target("sse2")))
+inline void validitySse2(const double* xs, const double* ys, size_t count, ValidityReason* reasons) {
+    const __m128d eps = _mm_set1_pd(EPS);
+    const __m128d signMask = _mm_set1_pd(-0.0);
+    constexpr size_t vertices = kind == FigureKind::Triangle ? 3 : 4;
+    const ReasonTable table(kind);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128d x[4], y[4];
+        for (size_t v = 0; v < vertices; ++v) {
+            x[v] = _mm_loadu_pd(xs + v * count + i);
+            y[v] = _mm_loadu_pd(ys + v * count + i);
+        }
+
+        __m128d duplicate = _mm_setzero_pd();
+        for (size_t a = 0; a < vertices; ++a) {
+            for (size_t b = a + 1; b < vertices; ++b) {
+                __m128d dx = _mm_andnot_pd(signMask, _mm_sub_pd(x[b], x[a]));
+                __m128d dy = _mm_andnot_pd(signMask, _mm_sub_pd(y[b], y[a]));
+                duplicate = _mm_or_pd(duplicate, _mm_and_pd(_mm_cmplt_pd(dx, eps), _mm_cmplt_pd(dy, eps)));
+            }
+        }
+
+        __m128d ux = _mm_sub_pd(x[1], x[0]);
+        __m128d uy = _mm_sub_pd(y[1], y[0]);
+        __m128d badShape;
+        __m128d badAngle = _mm_setzero_pd();
+        if constexpr (kind == FigureKind::Triangle) {
+            __m128d wx = _mm_sub_pd(x[2], x[0]);
+            __m128d wy = _mm_sub_pd(y[2], y[0]);
+            __m128d cross = _mm_sub_pd(_mm_mul_pd(ux, wy), _mm_mul_pd(wx, uy));
+            __m128d area = _mm_mul_pd(_mm_andnot_pd(signMask, cross), _mm_set1_pd(0.5));
+            badShape = _mm_cmpngt_pd(area, eps);
+        } else {
+            __m128d s[4];
+            for (size_t v = 0; v < 4; ++v) {
+                __m128d dx = _mm_sub_pd(x[(v + 1) % 4], x[v]);
+                __m128d dy = _mm_sub_pd(y[(v + 1) % 4], y[v]);
+                s[v] = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+            }
+            if constexpr (kind == FigureKind::Square) {
+                badShape = _mm_or_pd(_mm_or_pd(sidesDifferSse2(s[0], s[1]), sidesDifferSse2(s[1], s[2])),
+                                     sidesDifferSse2(s[2], s[3]));
+            } else {
+                badShape = _mm_or_pd(sidesDifferSse2(s[0], s[2]), sidesDifferSse2(s[1], s[3]));
+            }
+            __m128d wx = _mm_sub_pd(x[3], x[0]);
+            __m128d wy = _mm_sub_pd(y[3], y[0]);
+            __m128d dot = _mm_add_pd(_mm_mul_pd(ux, wx), _mm_mul_pd(uy, wy));
+            badAngle = _mm_cmpnlt_pd(_mm_andnot_pd(signMask, dot), eps);
+        }
+
+        storeReasons(table, _mm_movemask_pd(duplicate), _mm_movemask_pd(badShape),
+                     _mm_movemask_pd(badAngle), 2, reasons + i);
+    }
+    validityScalar(kind, xs, ys, count, i, reasons);
+}
+
+__attribute__((target("avx2")))
+inline __m256d sidesDifferAvx2(__m256d a, __m256d b) {
+    const __m256d e2 = _mm256_set1_pd(EPS * EPS);
+    __m256d sum = _mm256_add_pd(a, b);
+    __m256d difference = _mm256_sub_pd(a, b);
+    __m256d bound = _mm256_mul_pd(e2, _mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), sum), e2));
+    return _mm256_and_pd(_mm256_cmp_pd(sum, e2, _CMP_GT_OQ),
+                         _mm256_cmp_pd(_mm256_mul_pd(difference, difference), bound, _CMP_GT_OQ));
+}
+
+template <FigureKind kind>
+__attribute__((target("avx2")))
+inline void validityAvx2(const double* xs, const double* ys, size_t count, ValidityReason* reasons) {
+    const __m256d eps = _mm256_set1_pd(EPS);
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    constexpr size_t vertices = kind == FigureKind::Triangle ? 3 : 4;
+    const ReasonTable table(kind);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d x[4], y[4];
+        for (size_t v = 0; v < vertices; ++v) {
+            x[v] = _mm256_loadu_pd(xs + v * count + i);
+            y[v] = _mm256_loadu_pd(ys + v * count + i);
+        }
+
+        __m256d duplicate = _mm256_setzero_pd();
+        for (size_t a = 0; a < vertices; ++a) {
+            for (size_t b = a + 1; b < vertices; ++b) {
+                __m256d dx = _mm256_andnot_pd(signMask, _mm256_sub_pd(x[b], x[a]));
+                __m256d dy = _mm256_andnot_pd(signMask, _mm256_sub_pd(y[b], y[a]));
+                duplicate = _mm256_or_pd(duplicate, _mm256_and_pd(_mm256_cmp_pd(dx, eps, _CMP_LT_OQ),
+                                                                  _mm256_cmp_pd(dy, eps, _CMP_LT_OQ)));
+            }
+        }
+
+        __m256d ux = _mm256_sub_pd(x[1], x[0]);
+        __m256d uy = _mm256_sub_pd(y[1], y[0]);
+        __m256d badShape;
+        __m256d badAngle = _mm256_setzero_pd();
+        if constexpr (kind == FigureKind::Triangle) {
+            __m256d wx = _mm256_sub_pd(x[2], x[0]);
+            __m256d wy = _mm256_sub_pd(y[2], y[0]);
+            __m256d cross = _mm256_sub_pd(_mm256_mul_pd(ux, wy), _mm256_mul_pd(wx, uy));
+            __m256d area = _mm256_mul_pd(_mm256_andnot_pd(signMask, cross), _mm256_set1_pd(0.5));
+            badShape = _mm256_cmp_pd(area, eps, _CMP_NGT_UQ);
+        } else {
+            __m256d s[4];
+            for (size_t v = 0; v < 4; ++v) {
+                __m256d dx = _mm256_sub_pd(x[(v + 1) % 4], x[v]);
+                __m256d dy = _mm256_sub_pd(y[(v + 1) % 4], y[v]);
+                s[v] = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+            }
+            if constexpr (kind == FigureKind::Square) {
+                badShape = _mm256_or_pd(_mm256_or_pd(sidesDifferAvx2(s[0], s[1]), sidesDifferAvx2(s[1], s[2])),
+                                        sidesDifferAvx2(s[2], s[3]));
+            } else {
+                badShape = _mm256_or_pd(sidesDifferAvx2(s[0], s[2]), sidesDifferAvx2(s[1], s[3]));
+            }
+            __m256d wx = _mm256_sub_pd(x[3], x[0]);
+            __m256d wy = _mm256_sub_pd(y[3], y[0]);
+            __m256d dot = _mm256_add_pd(_mm256_mul_pd(ux, wx), _mm256_mul_pd(uy, wy));
+            badAngle = _mm256_cmp_pd(_mm256_andnot_pd(signMask, dot), eps, _CMP_NLT_UQ);
+        }
+
+        storeReasons(table, _mm256_movemask_pd(duplicate), _mm256_movemask_pd(badShape),
+                     _mm256_movemask_pd(badAngle), 4, reasons + i);
+    }
+    validityScalar(kind, xs, ys, count, i, reasons);
+}
+
+// Выбор специализации по виду фигуры
+template <template <FigureKind> class Kernel>
+void dispatchKind(FigureKind kind, const double* xs, const double* ys, size_t count, ValidityReason* reasons) {
+    switch (kind) {
+        case FigureKind::Triangle: Kernel<FigureKind::Triangle>::run(xs, ys, count, reasons); break;
+        case FigureKind::Square: Kernel<FigureKind::Square>::run(xs, ys, count, reasons); break;
+        case FigureKind::Rectangle: Kernel<FigureKind::Rectangle>::run(xs, ys, count, reasons); break;
+    }
+}
+
+template <FigureKind kind>
+struct Sse2Kernel {
+    static void run(const double* xs, const double* ys, size_t count, ValidityReason* reasons) {
+        validitySse2<kind>(xs, ys, count, reasons);
+    }
+};
+
+template <FigureKind kind>
+struct Avx2Kernel {
+    static void run(const double* xs, const double* ys, size_t count, ValidityReason* reasons) {
+        validityAvx2<kind>(xs, ys, count, reasons);
+    }
+};
+
+#endif
+
+} // namespace batch_validity_detail
+
+// Проверка count фигур вида kind в упакованном формате; в reasons записывается причина для каждой.
+// Уровень AVX512 выполняется путём AVX2 (проверка ограничена сравнениями, а не шириной вектора).
+inline void batchCheckValidity(FigureKind kind, const double* xs, const double* ys, size_t count,
+                               ValidityReason* reasons, SimdLevel level = detectSimdLevel()) {
+    switch (clampSimdLevel(level)) {
+#if FIGURES_SIMD_X86
+        case SimdLevel::AVX512:
+        case SimdLevel::AVX2:
+            batch_validity_detail::dispatchKind<batch_validity_detail::Avx2Kernel>(kind, xs, ys, count, reasons);
+            return;
+        case SimdLevel::SSE2:
+            batch_validity_detail::dispatchKind<batch_validity_detail::Sse2Kernel>(kind, xs, ys, count, reasons);
+            return;
+#endif
+        default:
+            batch_validity_detail::validityScalar(kind, xs, ys, count, 0, reasons);
+            return;
+    }
+}
+
+// Результат пакетной проверки: битовая маска валидных фигур (бит i слова i / 64) и причины
+struct ValidityReport {
+    std::vector<uint64_t> validMask;
+    std::vector<ValidityReason> reasons;
+    size_t validCount = 0;
+
+    size_t size() const { return reasons.size(); }
+
+    bool isValid(size_t index) const {
+        if (index >= reasons.size()) throw std::out_of_range("Index out of bounds");
+        return (validMask[index / 64] >> (index % 64)) & 1;
+    }
+
+    // Заполнение маски и счётчика по причинам
+    void buildMask() {
+        validMask.assign((reasons.size() + 63) / 64, 0);
+        validCount = 0;
+        for (size_t i = 0; i < reasons.size(); ++i) {
+            if (reasons[i] == ValidityReason::Valid) {
+                validMask[i / 64] |= uint64_t(1) << (i % 64);
+                ++validCount;
+            }
+        }
+    }
+};
+
+// Проверка всех фигур колоночного хранилища
+template <typename T>
+ValidityReport checkValidityBatch(const FigureColumnStore<T>& store, SimdLevel level = detectSimdLevel()) {
+    ValidityReport report;
+    report.reasons.assign(store.size(), ValidityReason::Valid);
+
+    if constexpr (std::is_integral_v<T>) {
+        Point<T> points[4];
+        for (size_t i = 0; i < store.size(); ++i) {
+            for (size_t v = 0; v < store.vertexCount(i); ++v) points[v] = store.getVertex(i, v);
+            report.reasons[i] = batch_validity_detail::exactReason(store.kind(i), points);
+        }
+        report.buildMask();
+        return report;
+    }
+
+    std::vector<double> xs, ys;
+    std::vector<size_t> indices;
+    std::vector<ValidityReason> packed;
+    for (FigureKind kind : {FigureKind::Triangle, FigureKind::Square, FigureKind::Rectangle}) {
+        store.packKind(kind, xs, ys, indices);
+        if (indices.empty()) continue;
+
+        packed.resize(indices.size());
+        batchCheckValidity(kind, xs.data(), ys.data(), indices.size(), packed.data(), level);
+        for (size_t j = 0; j < indices.size(); ++j) {
+            report.reasons[indices[j]] = packed[j];
+        }
+    }
+    report.buildMask();
+    return report;
+}
+
+#endif
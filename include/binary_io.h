@@ -0,0 +1,441 @@
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include "figure.h"
+#include "triangle.h"
+#include "square.h"
+#include "rectangle.h"
+#include "array.h"
+#include "column_store.h"
+
+// Двоичный формат файла фигур (версия 1), порядок байтов - порядок байтов машины.
+//
+//   Заголовок файла (32 байта):
+//     magic "FIGB" | uint16 version | uint8 scalarType | uint8 scalarSize |
+//     uint32 endianTag (0x01020304) | uint64 figureCount | 8 байт резерва
+//   Фрагменты (chunk), каждый с заголовком 16 байт:
+//     uint8 kind | uint8 vertexCount | uint16 резерв | uint32 count | uint64 payloadBytes
+//   Данные фрагмента: count фигур одного вида, координаты по плоскостям вершин -
+//     xs[v * count + i], затем ys[v * count + i] (тот же формат, что у batchShoelaceArea),
+//     дополнены нулями до кратности 8 байтам.
+//   Конец файла - фрагмент с kind = 0xFF и count = 0.
+
+namespace figure_binary {
+
+inline constexpr char magic[4] = {'F', 'I', 'G', 'B'};
+inline constexpr uint16_t version = 1;
+inline constexpr uint32_t endianTag = 0x01020304;
+inline constexpr uint8_t endKind = 0xFF;
+inline constexpr size_t fileHeaderSize = 32;
+inline constexpr size_t chunkHeaderSize = 16;
+inline constexpr size_t maxChunkCount = std::numeric_limits<uint32_t>::max();
+
+// Код скалярного типа: старшая тетрада - класс (1 - знаковое целое, 2 - беззнаковое, 3 - вещественное),
+// младшая - размер в байтах
+template <Scalar T>
+constexpr uint8_t scalarTypeCode() {
+    uint8_t family = std::is_floating_point_v<T> ? 3 : (std::is_signed_v<T> ? 1 : 2);
+    return static_cast<uint8_t>((family << 4) | sizeof(T));
+}
+
+struct FileHeader {
+    char magic[4];
+    uint16_t version;
+    uint8_t scalarType;
+    uint8_t scalarSize;
+    uint32_t endianTag;
+    uint32_t reserved0;
+    uint64_t figureCount;
+    uint64_t reserved1;
+};
+static_assert(sizeof(FileHeader) == fileHeaderSize);
+
+struct ChunkHeader {
+    uint8_t kind;
+    uint8_t vertexCount;
+    uint16_t reserved;
+    uint32_t count;
+    uint64_t payloadBytes;
+};
+static_assert(sizeof(ChunkHeader) == chunkHeaderSize);
+
+inline uint64_t paddedSize(uint64_t bytes) {
+    return (bytes + 7) & ~uint64_t(7);
+}
+
+inline size_t vertexCountOf(FigureKind kind) {
+    return kind == FigureKind::Triangle ? 3 : 4;
+}
+
+// Проверка заголовка файла для типа T
+template <Scalar T>
+void validateHeader(const FileHeader& header) {
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Not a figure binary file");
+    }
+    if (header.version != version) {
+        throw std::runtime_error("Unsupported figure file version");
+    }
+    if (header.endianTag != endianTag) {
+        throw std::runtime_error("Figure file has foreign byte order");
+    }
+    if (header.scalarType != scalarTypeCode<T>() || header.scalarSize != sizeof(T)) {
+        throw std::runtime_error("Figure file scalar type does not match");
+    }
+}
+
+// Проверка заголовка фрагмента
+inline void validateChunk(const ChunkHeader& chunk, size_t scalarSize) {
+    if (chunk.kind > static_cast<uint8_t>(FigureKind::Rectangle)) {
+        throw std::runtime_error("Unknown figure kind in chunk");
+    }
+    if (chunk.vertexCount != vertexCountOf(static_cast<FigureKind>(chunk.kind))) {
+        throw std::runtime_error("Chunk vertex count does not match figure kind");
+    }
+    uint64_t expected = paddedSize(uint64_t(2) * chunk.vertexCount * chunk.count * scalarSize);
+    if (chunk.payloadBytes != expected) {
+        throw std::runtime_error("Chunk payload size is inconsistent");
+    }
+}
+
+} // namespace figure_binary
+
+// Порядок фигур в файле
+enum class FigureOrder {
+    Preserve,    // Исходный порядок; фрагмент закрывается при смене вида фигуры
+    GroupByKind  // Фигуры группируются по видам (меньше фрагментов, порядок меняется)
+};
+
+// Шаблонный класс FigureBinaryWriter - потоковая запись фигур в двоичный формат.
+// Число фигур указывается заранее и записывается в заголовок; finish() проверяет его.
+template <Scalar T>
+class FigureBinaryWriter {
+private:
+    static constexpr size_t kindCount = 3;
+
+    std::ostream& _os;
+    uint64_t _declared;
+    uint64_t _written = 0;
+    size_t _chunkCapacity;
+    FigureOrder _order;
+    bool _finished = false;
+    std::array<std::vector<Point<T>>, kindCount> _buffers;  // Вершины подряд, по фигурам
+    std::vector<T> _plane;
+
+    void writeRaw(const void* data, size_t bytes) {
+        _os.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        if (!_os) throw std::runtime_error("Failed to write figure file");
+    }
+
+    void flush(size_t kindIndex) {
+        std::vector<Point<T>>& buffer = _buffers[kindIndex];
+        if (buffer.empty()) return;
+
+        FigureKind kind = static_cast<FigureKind>(kindIndex);
+        size_t vertices = figure_binary::vertexCountOf(kind);
+        size_t count = buffer.size() / vertices;
+        uint64_t bytes = uint64_t(2) * vertices * count * sizeof(T);
+
+        figure_binary::ChunkHeader header{};
+        header.kind = static_cast<uint8_t>(kind);
+        header.vertexCount = static_cast<uint8_t>(vertices);
+        header.count = static_cast<uint32_t>(count);
+        header.payloadBytes = figure_binary::paddedSize(bytes);
+        writeRaw(&header, sizeof(header));
+
+        // Плоскость x, затем плоскость y
+        _plane.resize(vertices * count * 2);
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t v = 0; v < vertices; ++v) {
+                const Point<T>& point = buffer[i * vertices + v];
+                _plane[v * count + i] = point.getX();
+                _plane[vertices * count + v * count + i] = point.getY();
+            }
+        }
+        writeRaw(_plane.data(), bytes);
+
+        static const char zeros[8] = {};
+        writeRaw(zeros, header.payloadBytes - bytes);
+        buffer.clear();
+    }
+
+public:
+    FigureBinaryWriter(std::ostream& os, uint64_t figureCount,
+                       FigureOrder order = FigureOrder::Preserve, size_t chunkCapacity = 65536)
+        : _os(os), _declared(figureCount),
+          _chunkCapacity(std::clamp<size_t>(chunkCapacity, 1, figure_binary::maxChunkCount)), _order(order) {
+        figure_binary::FileHeader header{};
+        std::memcpy(header.magic, figure_binary::magic, sizeof(header.magic));
+        header.version = figure_binary::version;
+        header.scalarType = figure_binary::scalarTypeCode<T>();
+        header.scalarSize = sizeof(T);
+        header.endianTag = figure_binary::endianTag;
+        header.figureCount = figureCount;
+        writeRaw(&header, sizeof(header));
+    }
+
+    FigureBinaryWriter(const FigureBinaryWriter& other) = delete;
+    FigureBinaryWriter& operator=(const FigureBinaryWriter& other) = delete;
+
+    void write(const Figure<T>& figure) {
+        if (_finished) throw std::logic_error("Figure writer is already finished");
+        if (_written >= _declared) throw std::logic_error("More figures written than declared");
+
+        size_t kindIndex = static_cast<size_t>(figure.kind());
+        if (_order == FigureOrder::Preserve) {
+            for (size_t k = 0; k < kindCount; ++k) {
+                if (k != kindIndex) flush(k);
+            }
+        }
+
+        std::vector<Point<T>>& buffer = _buffers[kindIndex];
+        for (size_t v = 0; v < figure.vertexCount(); ++v) {
+            buffer.push_back(figure.getVertex(v));
+        }
+        ++_written;
+
+        if (buffer.size() / figure.vertexCount() >= _chunkCapacity) {
+            flush(kindIndex);
+        }
+    }
+
+    // Запись оставшихся фрагментов и маркера конца файла
+    void finish() {
+        if (_finished) return;
+        if (_written != _declared) throw std::logic_error("Fewer figures written than declared");
+        for (size_t k = 0; k < kindCount; ++k) {
+            flush(k);
+        }
+        figure_binary::ChunkHeader end{};
+        end.kind = figure_binary::endKind;
+        writeRaw(&end, sizeof(end));
+        _os.flush();
+        _finished = true;
+    }
+
+    uint64_t written() const { return _written; }
+};
+
+// Сведения о фрагменте, доступные до чтения его данных
+struct FigureChunkInfo {
+    FigureKind kind;
+    size_t vertexCount;
+    size_t count;
+};
+
+// Шаблонный класс FigureBinaryReader - потоковое чтение фигур по фрагментам.
+// Фрагмент можно загрузить в FigureArray/FigureColumnStore, получить как плоскости координат
+// или пропустить, не читая данные.
+// Размеры из заголовков не заслуживают доверия: если длина потока известна, число фигур и размеры
+// фрагментов сверяются с оставшимися байтами до выделения памяти; иначе буферы растут по мере чтения.
+template <Scalar T>
+class FigureBinaryReader {
+private:
+    // Наименьший объём данных одной фигуры (треугольник)
+    static constexpr uint64_t minFigureBytes = 2 * 3 * sizeof(T);
+    // Шаг чтения плоскостей и предел резервирования для потоков неизвестной длины
+    static constexpr size_t readBlockValues = size_t(1) << 16;
+
+    std::istream& _is;
+    uint64_t _figureCount;
+    std::optional<uint64_t> _remaining;  // Непрочитанные байты, если длина потока известна
+    figure_binary::ChunkHeader _chunk{};
+    bool _hasChunk = false;
+    bool _atEnd = false;
+    std::vector<T> _xs, _ys;  // Буферы текущего фрагмента (переиспользуются между фрагментами)
+
+    void consumed(uint64_t bytes) {
+        if (_remaining) *_remaining -= std::min(*_remaining, bytes);
+    }
+
+    void readRaw(void* data, size_t bytes) {
+        _is.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes));
+        if (static_cast<size_t>(_is.gcount()) != bytes) throw std::runtime_error("Truncated figure file");
+        consumed(bytes);
+    }
+
+    // Чтение values значений блоками: память растёт вместе с фактически прочитанными данными
+    void readValues(std::vector<T>& out, size_t values) {
+        out.clear();
+        for (size_t done = 0; done < values;) {
+            size_t step = std::min(values - done, readBlockValues);
+            out.resize(done + step);
+            readRaw(out.data() + done, step * sizeof(T));
+            done += step;
+        }
+    }
+
+    // Длина остатка потока, если он поддерживает позиционирование
+    void measureRemaining() {
+        std::streampos here = _is.tellg();
+        if (here == std::streampos(-1)) return;
+        _is.seekg(0, std::ios::end);
+        std::streampos end = _is.tellg();
+        _is.seekg(here);
+        if (!_is || end == std::streampos(-1) || end < here) {
+            _is.clear();
+            _is.seekg(here);
+            return;
+        }
+        _remaining = static_cast<uint64_t>(end - here);
+    }
+
+    void requireChunk() const {
+        if (!_hasChunk) throw std::logic_error("No current chunk; call nextChunk() first");
+    }
+
+public:
+    explicit FigureBinaryReader(std::istream& is) : _is(is) {
+        figure_binary::FileHeader header{};
+        readRaw(&header, sizeof(header));
+        figure_binary::validateHeader<T>(header);
+        _figureCount = header.figureCount;
+        measureRemaining();
+        if (_remaining && _figureCount > *_remaining / minFigureBytes) {
+            throw std::runtime_error("Figure count does not match file size");
+        }
+    }
+
+    uint64_t figureCount() const { return _figureCount; }
+
+    // Число фигур для предварительного резервирования: заявленное, если оно сверено с длиной
+    // потока, иначе не больше одного блока чтения
+    size_t reservableCount() const {
+        if (_remaining) return static_cast<size_t>(_figureCount);
+        return static_cast<size_t>(std::min<uint64_t>(_figureCount, readBlockValues));
+    }
+
+    // Переход к следующему фрагменту (текущий непрочитанный фрагмент пропускается).
+    // Возвращает false в конце файла.
+    bool nextChunk(FigureChunkInfo& info) {
+        if (_hasChunk) skipChunk();
+        if (_atEnd) return false;
+
+        readRaw(&_chunk, sizeof(_chunk));
+        if (_chunk.kind == figure_binary::endKind) {
+            _atEnd = true;
+            return false;
+        }
+        figure_binary::validateChunk(_chunk, sizeof(T));
+        if (_remaining && _chunk.payloadBytes > *_remaining) throw std::runtime_error("Truncated figure file");
+        _hasChunk = true;
+        info = FigureChunkInfo{static_cast<FigureKind>(_chunk.kind), _chunk.vertexCount, _chunk.count};
+        return true;
+    }
+
+    void skipChunk() {
+        requireChunk();
+        _is.ignore(static_cast<std::streamsize>(_chunk.payloadBytes));
+        if (static_cast<uint64_t>(_is.gcount()) != _chunk.payloadBytes) throw std::runtime_error("Truncated figure file");
+        consumed(_chunk.payloadBytes);
+        _hasChunk = false;
+    }
+
+    // Координаты фрагмента в формате плоскостей: xs[v * count + i], ys[v * count + i]
+    void readChunkPlanes(std::vector<T>& xs, std::vector<T>& ys) {
+        requireChunk();
+        size_t values = size_t(_chunk.vertexCount) * _chunk.count;
+        readValues(xs, values);
+        readValues(ys, values);
+
+        char padding[8];
+        readRaw(padding, _chunk.payloadBytes - 2 * values * sizeof(T));
+        _hasChunk = false;
+    }
+
+    // Загрузка фрагмента в колоночное хранилище
+    void readChunk(FigureColumnStore<T>& store) {
+        requireChunk();
+        FigureKind kind = static_cast<FigureKind>(_chunk.kind);
+        size_t vertices = _chunk.vertexCount;
+        size_t count = _chunk.count;
+
+        readChunkPlanes(_xs, _ys);
+        Point<T> points[4];
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t v = 0; v < vertices; ++v) {
+                points[v] = Point<T>(_xs[v * count + i], _ys[v * count + i]);
+            }
+            store.add(kind, points, vertices);
+        }
+    }
+
+    // Загрузка фрагмента в FigureArray (фигуры создаются через emplace)
+    template <typename Ownership>
+    void readChunk(FigureArray<T, Ownership>& array) {
+        requireChunk();
+        FigureKind kind = static_cast<FigureKind>(_chunk.kind);
+        size_t count = _chunk.count;
+
+        readChunkPlanes(_xs, _ys);
+        auto p = [&](size_t v, size_t i) { return Point<T>(_xs[v * count + i], _ys[v * count + i]); };
+        for (size_t i = 0; i < count; ++i) {
+            switch (kind) {
+                case FigureKind::Triangle:
+                    array.template emplace<Triangle<T>>(p(0, i), p(1, i), p(2, i));
+                    break;
+                case FigureKind::Square:
+                    array.template emplace<Square<T>>(p(0, i), p(1, i), p(2, i), p(3, i));
+                    break;
+                case FigureKind::Rectangle:
+                    array.template emplace<Rectangle<T>>(p(0, i), p(1, i), p(2, i), p(3, i));
+                    break;
+            }
+        }
+    }
+};
+
+// Запись всего массива
+template <Scalar T, typename Ownership>
+void writeFigureArray(std::ostream& os, const FigureArray<T, Ownership>& array,
+                      FigureOrder order = FigureOrder::Preserve) {
+    FigureBinaryWriter<T> writer(os, array.size(), order);
+    for (size_t i = 0; i < array.size(); ++i) {
+        writer.write(array[i]);
+    }
+    writer.finish();
+}
+
+// Чтение всего файла в FigureArray
+template <Scalar T>
+FigureArray<T> readFigureArray(std::istream& is) {
+    FigureBinaryReader<T> reader(is);
+    FigureArray<T> array(std::pmr::get_default_resource(), ArenaPolicy::Pool);
+    array.reserve(reader.reservableCount());
+    FigureChunkInfo info;
+    while (reader.nextChunk(info)) {
+        reader.readChunk(array);
+    }
+    if (array.size() != reader.figureCount()) {
+        throw std::runtime_error("Figure count does not match file header");
+    }
+    return array;
+}
+
+// Чтение всего файла в колоночное хранилище (без создания объектов фигур)
+template <Scalar T>
+FigureColumnStore<T> readFigureColumnStore(std::istream& is) {
+    FigureBinaryReader<T> reader(is);
+    FigureColumnStore<T> store;
+    size_t reservable = reader.reservableCount();
+    store.reserve(reservable, reservable * 4);
+    FigureChunkInfo info;
+    while (reader.nextChunk(info)) {
+        reader.readChunk(store);
+    }
+    if (store.size() != reader.figureCount()) {
+        throw std::runtime_error("Figure count does not match file header");
+    }
+    return store;
+}
+
+#endif
@@ -0,0 +1,216 @@
+#ifndef CANONICAL_H
+#define CANONICAL_H
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <unordered_map>
+#include "figure.h"
+
+// Каноническая форма фигуры для хеширования.
+//
+// Координаты вершин делятся на ячейки размера quantum с центрами в кратных quantum
+// (floor(x / quantum + 1/2)), поэтому целые и "круглые" координаты лежат далеко от границ.
+// Затем последовательность ячеек циклически сдвигается так, чтобы она была лексикографически
+// наименьшей. Поэтому фигуры, отличающиеся только начальной вершиной (как в operator==), имеют одну форму.
+// Равные по operator== фигуры могут оказаться по разные стороны границы ячейки, поэтому
+// при индексации фигура заносится под все формы из canonicalForms(), а ищется по одной
+// canonicalForm(); совпадение формы всегда перепроверяется operator==.
+struct CanonicalForm {
+    FigureKind kind = FigureKind::Triangle;
+    unsigned char vertexCount = 0;
+    std::array<int64_t, 8> coordinates{};  // x0, y0, x1, y1, ... (неиспользуемые - нули)
+
+    bool operator==(const CanonicalForm& other) const = default;
+};
+
+struct CanonicalFormHash {
+    size_t operator()(const CanonicalForm& form) const {
+        // Перемешивание splitmix64 по всем координатам
+        uint64_t hash = static_cast<uint64_t>(form.kind) * 0x9E3779B97F4A7C15ull + form.vertexCount;
+        for (size_t i = 0; i < 2 * size_t(form.vertexCount); ++i) {
+            hash ^= static_cast<uint64_t>(form.coordinates[i]) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+            hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+            hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+            hash ^= hash >> 31;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+// Размер ячейки по умолчанию. Ячейка много больше EPS, поэтому соседние ячейки
+// приходится перебирать только для координат у самой границы
+inline constexpr double canonicalQuantum = 100 * EPS;
+
+namespace canonical_detail {
+
+// Запас у границы ячейки: координаты, равные по operator==, отличаются меньше чем на EPS,
+// удвоение покрывает округление при вычитании в типе T
+inline constexpr double boundaryMargin = 2 * EPS;
+
+inline void checkQuantum(double quantum) {
+    if (!(quantum >= 2 * boundaryMargin)) {
+        throw std::invalid_argument("Canonical quantum must be at least 4 * EPS");
+    }
+}
+
+inline int64_t cellOf(double value, double quantum) {
+    return static_cast<int64_t>(std::floor(value / quantum + 0.5));
+}
+
+// Форма по ячейкам вершин: наименьший циклический сдвиг
+inline CanonicalForm formFromCells(FigureKind kind, size_t n, const std::array<std::pair<int64_t, int64_t>, 4>& vertices) {
+    size_t best = 0;
+    for (size_t shift = 1; shift < n; ++shift) {
+        for (size_t i = 0; i < n; ++i) {
+            const auto& candidate = vertices[(shift + i) % n];
+            const auto& current = vertices[(best + i) % n];
+            if (candidate != current) {
+                if (candidate < current) best = shift;
+                break;
+            }
+        }
+    }
+
+    CanonicalForm form;
+    form.kind = kind;
+    form.vertexCount = static_cast<unsigned char>(n);
+    for (size_t i = 0; i < n; ++i) {
+        form.coordinates[2 * i] = vertices[(best + i) % n].first;
+        form.coordinates[2 * i + 1] = vertices[(best + i) % n].second;
+    }
+    return form;
+}
+
+}  // namespace canonical_detail
+
+// Каноническая форма фигуры (координаты должны быть конечными и по модулю меньше 2^63 * quantum).
+// quantum не меньше 4 * EPS, иначе std::invalid_argument
+template <Scalar T>
+CanonicalForm canonicalForm(const Figure<T>& figure, double quantum = canonicalQuantum) {
+    canonical_detail::checkQuantum(quantum);
+    size_t n = figure.vertexCount();
+    std::array<std::pair<int64_t, int64_t>, 4> vertices;
+    for (size_t v = 0; v < n; ++v) {
+        Point<T> point = figure.getVertex(v);
+        vertices[v] = {canonical_detail::cellOf(static_cast<double>(point.getX()), quantum),
+                       canonical_detail::cellOf(static_cast<double>(point.getY()), quantum)};
+    }
+    return canonical_detail::formFromCells(figure.kind(), n, vertices);
+}
+
+// Все формы, которые может иметь равная по operator== фигура: для координаты у границы
+// ячейки берётся и соседняя ячейка. Формы без повторов; первая - canonicalForm(figure).
+// Обычно форма одна, в худшем случае (все координаты у границ) - 2^(2 * число вершин)
+template <Scalar T>
+std::vector<CanonicalForm> canonicalForms(const Figure<T>& figure, double quantum = canonicalQuantum) {
+    using canonical_detail::boundaryMargin;
+    using canonical_detail::cellOf;
+    canonical_detail::checkQuantum(quantum);
+
+    size_t n = figure.vertexCount();
+    std::array<int64_t, 8> low{};
+    std::array<int64_t, 8> high{};
+    std::array<size_t, 8> ambiguous{};  // Координаты с двумя возможными ячейками
+    size_t ambiguousCount = 0;
+    for (size_t v = 0; v < n; ++v) {
+        Point<T> point = figure.getVertex(v);
+        double values[2] = {static_cast<double>(point.getX()), static_cast<double>(point.getY())};
+        for (size_t c = 0; c < 2; ++c) {
+            size_t k = 2 * v + c;
+            int64_t cell = cellOf(values[c], quantum);
+            low[k] = std::min(cell, cellOf(values[c] - boundaryMargin, quantum));
+            high[k] = std::max(cell, cellOf(values[c] + boundaryMargin, quantum));
+            if (high[k] != low[k]) ambiguous[ambiguousCount++] = k;
+        }
+    }
+
+    std::vector<CanonicalForm> forms{canonicalForm(figure, quantum)};
+    for (uint32_t mask = 0; mask < (1u << ambiguousCount); ++mask) {
+        std::array<int64_t, 8> cells = low;
+        for (size_t a = 0; a < ambiguousCount; ++a) {
+            if (mask & (1u << a)) cells[ambiguous[a]] = high[ambiguous[a]];
+        }
+        std::array<std::pair<int64_t, int64_t>, 4> vertices;
+        for (size_t v = 0; v < n; ++v) vertices[v] = {cells[2 * v], cells[2 * v + 1]};
+        CanonicalForm form = canonical_detail::formFromCells(figure.kind(), n, vertices);
+        if (std::find(forms.begin(), forms.end(), form) == forms.end()) forms.push_back(form);
+    }
+    return forms;
+}
+
+// Группировка равных фигур: для каждой фигуры - индекс первой равной ей (по operator==) фигуры.
+// at(i) возвращает const Figure<T>&. Ожидаемое время O(n).
+template <typename At>
+std::vector<size_t> groupEqualFigures(size_t count, At at, double quantum = canonicalQuantum) {
+    // Для каждой формы - представители (фигуры, не равные предыдущим) по возрастанию индекса
+    std::unordered_map<CanonicalForm, std::vector<size_t>, CanonicalFormHash> representatives;
+    representatives.reserve(count);
+    std::vector<size_t> group(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        group[i] = i;
+        auto it = representatives.find(canonicalForm(at(i), quantum));
+        if (it != representatives.end()) {
+            for (size_t representative : it->second) {
+                if (at(representative) == at(i)) {
+                    group[i] = representative;
+                    break;
+                }
+            }
+        }
+        if (group[i] != i) continue;
+
+        for (const CanonicalForm& form : canonicalForms(at(i), quantum)) {
+            representatives[form].push_back(i);
+        }
+    }
+    return group;
+}
+
+// Группы из двух и более равных фигур по результату groupEqualFigures: индексы по возрастанию,
+// группы - по первому индексу
+inline std::vector<std::vector<size_t>> duplicateGroups(const std::vector<size_t>& group) {
+    std::vector<size_t> slot(group.size(), static_cast<size_t>(-1));
+    std::vector<std::vector<size_t>> groups;
+    for (size_t i = 0; i < group.size(); ++i) {
+        if (group[i] == i) continue;
+        size_t first = group[i];
+        if (slot[first] == static_cast<size_t>(-1)) {
+            slot[first] = groups.size();
+            groups.push_back({first});
+        }
+        groups[slot[first]].push_back(i);
+    }
+    return groups;
+}
+
+// Хеш-соединение двух наборов фигур (FigureArray, StaticFigureArray): все пары (i, j),
+// для которых left[i] == right[j], по возрастанию i, затем j. Ожидаемое время O(n + m + k).
+template <typename Left, typename Right>
+std::vector<std::pair<size_t, size_t>> hashJoin(const Left& left, const Right& right, double quantum = canonicalQuantum) {
+    // Для каждой формы - индексы right по возрастанию
+    std::unordered_map<CanonicalForm, std::vector<size_t>, CanonicalFormHash> buckets;
+    buckets.reserve(right.size());
+    for (size_t j = 0; j < right.size(); ++j) {
+        for (const CanonicalForm& form : canonicalForms(right[j], quantum)) {
+            buckets[form].push_back(j);
+        }
+    }
+
+    std::vector<std::pair<size_t, size_t>> matches;
+    for (size_t i = 0; i < left.size(); ++i) {
+        auto it = buckets.find(canonicalForm(left[i], quantum));
+        if (it == buckets.end()) continue;
+        for (size_t j : it->second) {
+            if (left[i] == right[j]) matches.emplace_back(i, j);
+        }
+    }
+    return matches;
+}
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include "figure.h"
+#include "parallel.h"
+#include "ordering.h"
+
+// Поиск пересекающихся фигур.
+//
+// Широкая фаза - sweep-and-prune по оси X внутри горизонтальных полос. Плоскость делится на
+// полосы высотой не меньше средней высоты фигуры, фигура попадает во все полосы, которые
+// пересекает её ограничивающий прямоугольник (в сумме не больше 2n вхождений). В каждой полосе
+// вхождения сортируются по minX, для каждой фигуры просматриваются следующие, пока их minX
+// не превысит её maxX, и отбрасываются пары без перекрытия по Y. Пара проверяется только в полосе,
+// где начинается перекрытие по Y (max(minY)), поэтому не повторяется. Полосы обрабатываются
+// параллельно. Без полос одна ось вырождается на сеточных раскладках: фигуры одного столбца
+// перекрываются по X все со всеми.
+// Узкая фаза - теорема о разделяющей оси для выпуклых многоугольников (треугольник, квадрат,
+// прямоугольник): оси - нормали рёбер обеих фигур. Фигуры считаются замкнутыми: касание по
+// границе - пересечение. Фигуры с нечисловыми координатами пропускаются.
+// Время O(n log n + s), где s - число пар с перекрытием по X внутри полос (для разреженных наборов s ~ k).
+
+// Вершины фигуры в double и её ограничивающий прямоугольник
+struct CollisionShape {
+    double xs[4] = {};
+    double ys[4] = {};
+    size_t count = 0;
+    double minX = 0.0;
+    double minY = 0.0;
+    double maxX = 0.0;
+    double maxY = 0.0;
+
+    template <Scalar T>
+    explicit CollisionShape(const Figure<T>& figure) : count(figure.vertexCount()) {
+        for (size_t v = 0; v < count; ++v) {
+            Point<T> point = figure.getVertex(v);
+            xs[v] = static_cast<double>(point.getX());
+            ys[v] = static_cast<double>(point.getY());
+        }
+        minX = maxX = xs[0];
+        minY = maxY = ys[0];
+        for (size_t v = 1; v < count; ++v) {
+            minX = std::min(minX, xs[v]);
+            maxX = std::max(maxX, xs[v]);
+            minY = std::min(minY, ys[v]);
+            maxY = std::max(maxY, ys[v]);
+        }
+    }
+
+    CollisionShape() = default;
+};
+
+namespace collision_detail {
+
+// Есть ли среди нормалей рёбер first ось, разделяющая first и second
+inline bool hasSeparatingAxis(const CollisionShape& first, const CollisionShape& second) {
+    for (size_t v = 0; v < first.count; ++v) {
+        size_t next = v + 1 == first.count ? 0 : v + 1;
+        double nx = first.ys[v] - first.ys[next];
+        double ny = first.xs[next] - first.xs[v];
+
+        double minFirst = nx * first.xs[0] + ny * first.ys[0];
+        double maxFirst = minFirst;
+        for (size_t u = 1; u < first.count; ++u) {
+            double projection = nx * first.xs[u] + ny * first.ys[u];
+            minFirst = std::min(minFirst, projection);
+            maxFirst = std::max(maxFirst, projection);
+        }
+        double minSecond = nx * second.xs[0] + ny * second.ys[0];
+        double maxSecond = minSecond;
+        for (size_t u = 1; u < second.count; ++u) {
+            double projection = nx * second.xs[u] + ny * second.ys[u];
+            minSecond = std::min(minSecond, projection);
+            maxSecond = std::max(maxSecond, projection);
+        }
+        if (maxFirst < minSecond || maxSecond < minFirst) return true;
+    }
+    return false;
+}
+
+} // namespace collision_detail
+
+// Узкая фаза для двух выпуклых фигур
+inline bool shapesIntersect(const CollisionShape& a, const CollisionShape& b) {
+    if (a.maxX < b.minX || b.maxX < a.minX || a.maxY < b.minY || b.maxY < a.minY) return false;
+    return !collision_detail::hasSeparatingAxis(a, b) && !collision_detail::hasSeparatingAxis(b, a);
+}
+
+template <Scalar T>
+bool figuresIntersect(const Figure<T>& a, const Figure<T>& b) {
+    return shapesIntersect(CollisionShape(a), CollisionShape(b));
+}
+
+namespace collision_detail {
+
+inline constexpr size_t collisionChunkSize = 4096;
+
+inline bool isFinite(const CollisionShape& shape) {
+    return std::isfinite(shape.minX) && std::isfinite(shape.maxX) &&
+           std::isfinite(shape.minY) && std::isfinite(shape.maxY);
+}
+
+// Фигуры контейнера в виде CollisionShape (параллельно по фрагментам)
+template <typename Array>
+std::vector<CollisionShape> buildShapes(const Array& array, ThreadPool& pool) {
+    size_t count = array.size();
+    std::vector<CollisionShape> shapes(count);
+    pool.parallelFor((count + collisionChunkSize - 1) / collisionChunkSize, [&](size_t chunk) {
+        size_t end = std::min(count, (chunk + 1) * collisionChunkSize);
+        for (size_t i = chunk * collisionChunkSize; i < end; ++i) {
+            shapes[i] = CollisionShape(array[i]);
+        }
+    });
+    return shapes;
+}
+
+// Широкая и узкая фазы над готовыми фигурами
+inline std::vector<std::pair<size_t, size_t>> intersectingPairs(const std::vector<CollisionShape>& shapes, ThreadPool& pool) {
+    using ordering_detail::KeyedIndex;
+    size_t count = shapes.size();
+
+    // Высота полосы: не меньше средней высоты фигуры и не больше n полос
+    size_t finiteCount = 0;
+    double bottom = std::numeric_limits<double>::infinity();
+    double top = -std::numeric_limits<double>::infinity();
+    double heightSum = 0.0;
+    for (const CollisionShape& shape : shapes) {
+        if (!isFinite(shape)) continue;
+        ++finiteCount;
+        bottom = std::min(bottom, shape.minY);
+        top = std::max(top, shape.maxY);
+        heightSum += shape.maxY - shape.minY;
+    }
+    if (finiteCount < 2) return {};
+    double span = top - bottom;
+    double stripHeight = std::max(heightSum / static_cast<double>(finiteCount), span / static_cast<double>(finiteCount));
+    size_t strips = stripHeight > 0 ? std::min(finiteCount, static_cast<size_t>(span / stripHeight) + 1) : 1;
+    auto stripOf = [&](double y) {
+        if (strips == 1) return size_t(0);
+        return std::min(strips - 1, static_cast<size_t>((y - bottom) / stripHeight));
+    };
+
+    // Вхождения фигур в полосы (сортировка подсчётом)
+    std::vector<size_t> stripStart(strips + 1, 0);
+    for (const CollisionShape& shape : shapes) {
+        if (!isFinite(shape)) continue;
+        for (size_t strip = stripOf(shape.minY); strip <= stripOf(shape.maxY); ++strip) ++stripStart[strip + 1];
+    }
+    for (size_t strip = 0; strip < strips; ++strip) stripStart[strip + 1] += stripStart[strip];
+    std::vector<KeyedIndex> entries(stripStart[strips]);
+    std::vector<size_t> fill(stripStart.begin(), stripStart.end() - 1);
+    for (size_t i = 0; i < count; ++i) {
+        if (!isFinite(shapes[i])) continue;
+        for (size_t strip = stripOf(shapes[i].minY); strip <= stripOf(shapes[i].maxY); ++strip) {
+            entries[fill[strip]++] = {shapes[i].minX, i};
+        }
+    }
+
+    std::vector<std::vector<std::pair<size_t, size_t>>> found(strips);
+    pool.parallelFor(strips, [&](size_t strip) {
+        auto first = entries.begin() + static_cast<std::ptrdiff_t>(stripStart[strip]);
+        auto last = entries.begin() + static_cast<std::ptrdiff_t>(stripStart[strip + 1]);
+        std::sort(first, last, ordering_detail::keyedLess);
+        for (auto p = first; p != last; ++p) {
+            const CollisionShape& a = shapes[p->index];
+            for (auto q = p + 1; q != last && q->key <= a.maxX; ++q) {
+                const CollisionShape& b = shapes[q->index];
+                if (a.maxY < b.minY || b.maxY < a.minY) continue;
+                if (stripOf(std::max(a.minY, b.minY)) != strip) continue;
+                if (shapesIntersect(a, b)) {
+                    found[strip].emplace_back(std::min(p->index, q->index), std::max(p->index, q->index));
+                }
+            }
+        }
+    });
+
+    std::vector<std::pair<size_t, size_t>> pairs;
+    size_t total = 0;
+    for (const auto& part : found) total += part.size();
+    pairs.reserve(total);
+    for (const auto& part : found) pairs.insert(pairs.end(), part.begin(), part.end());
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+} // namespace collision_detail
+
+// Все пары (i, j), i < j, пересекающихся фигур контейнера с size() и operator[]
+// (FigureArray, StaticFigureArray); пары упорядочены по i, затем по j
+template <typename Array>
+std::vector<std::pair<size_t, size_t>> findIntersectingPairs(const Array& array, ThreadPool& pool = defaultThreadPool()) {
+    return collision_detail::intersectingPairs(collision_detail::buildShapes(array, pool), pool);
+}
+
+#endif
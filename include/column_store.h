@@ -0,0 +1,289 @@
+#ifndef COLUMN_STORE_H
+#define COLUMN_STORE_H
+
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <cmath>
+#include "figure.h"
+#include "exact.h"
+#include "triangle.h"
+#include "square.h"
+#include "rectangle.h"
+#include "array.h"
+
+// Шаблонный класс FigureColumnStore - колоночное (structure-of-arrays) хранилище фигур.
+// Вид фигуры, число вершин и координаты хранятся в плоских массивах, поэтому
+// проходы по площади, центроидам и валидности читают память последовательно.
+template <typename T>
+class FigureColumnStore {
+private:
+    std::vector<FigureKind> _kinds;
+    std::vector<unsigned char> _vertexCounts;
+    std::vector<size_t> _offsets;  // Индекс первой вершины фигуры в столбцах _xs/_ys
+    std::vector<T> _xs;
+    std::vector<T> _ys;
+
+    static size_t expectedVertexCount(FigureKind kind) {
+        return kind == FigureKind::Triangle ? 3 : 4;
+    }
+
+    void checkIndex(size_t index) const {
+        if (index >= _kinds.size()) throw std::out_of_range("Index out of bounds");
+    }
+
+    double dx(size_t from, size_t to) const {
+        return static_cast<double>(_xs[to]) - static_cast<double>(_xs[from]);
+    }
+
+    double dy(size_t from, size_t to) const {
+        return static_cast<double>(_ys[to]) - static_cast<double>(_ys[from]);
+    }
+
+    double squaredLength(size_t from, size_t to) const {
+        return dx(from, to) * dx(from, to) + dy(from, to) * dy(from, to);
+    }
+
+public:
+    FigureColumnStore() = default;
+
+    // Построение из FigureArray
+    template <typename Ownership>
+    explicit FigureColumnStore(const FigureArray<T, Ownership>& array) {
+        reserve(array.size(), array.size() * 4);
+        for (size_t i = 0; i < array.size(); ++i) {
+            add(array[i]);
+        }
+    }
+
+    void reserve(size_t figures, size_t vertices) {
+        _kinds.reserve(figures);
+        _vertexCounts.reserve(figures);
+        _offsets.reserve(figures);
+        _xs.reserve(vertices);
+        _ys.reserve(vertices);
+    }
+
+    // Добавление фигуры по виду и массиву вершин
+    void add(FigureKind kind, const Point<T>* points, size_t count) {
+        if (count != expectedVertexCount(kind)) {
+            throw std::invalid_argument("Vertex count does not match figure kind");
+        }
+        _kinds.push_back(kind);
+        _vertexCounts.push_back(static_cast<unsigned char>(count));
+        _offsets.push_back(_xs.size());
+        for (size_t v = 0; v < count; ++v) {
+            _xs.push_back(points[v].getX());
+            _ys.push_back(points[v].getY());
+        }
+    }
+
+    // Добавление копии существующей фигуры
+    void add(const Figure<T>& figure) {
+        _kinds.push_back(figure.kind());
+        _vertexCounts.push_back(static_cast<unsigned char>(figure.vertexCount()));
+        _offsets.push_back(_xs.size());
+        for (size_t v = 0; v < figure.vertexCount(); ++v) {
+            Point<T> point = figure.getVertex(v);
+            _xs.push_back(point.getX());
+            _ys.push_back(point.getY());
+        }
+    }
+
+    void clear() {
+        _kinds.clear();
+        _vertexCounts.clear();
+        _offsets.clear();
+        _xs.clear();
+        _ys.clear();
+    }
+
+    size_t size() const { return _kinds.size(); }
+    size_t totalVertices() const { return _xs.size(); }
+
+    // Доступ к столбцам
+    FigureKind kind(size_t index) const {
+        checkIndex(index);
+        return _kinds[index];
+    }
+
+    size_t vertexCount(size_t index) const {
+        checkIndex(index);
+        return _vertexCounts[index];
+    }
+
+    size_t offset(size_t index) const {
+        checkIndex(index);
+        return _offsets[index];
+    }
+
+    Point<T> getVertex(size_t index, size_t vertex) const {
+        checkIndex(index);
+        if (vertex >= _vertexCounts[index]) throw std::out_of_range("Vertex index out of bounds");
+        size_t at = _offsets[index] + vertex;
+        return Point<T>(_xs[at], _ys[at]);
+    }
+
+    const T* xData() const { return _xs.data(); }
+    const T* yData() const { return _ys.data(); }
+
+    // Упаковка фигур одного вида "по вершинам": координата вершины v j-й найденной фигуры
+    // записывается в xs[v * count + j], в indices - её индекс в хранилище.
+    // Возвращает число вершин у фигур этого вида.
+    template <typename U>
+    size_t packKind(FigureKind kind, std::vector<U>& xs, std::vector<U>& ys,
+                    std::vector<size_t>& indices) const {
+        indices.clear();
+        for (size_t i = 0; i < _kinds.size(); ++i) {
+            if (_kinds[i] == kind) indices.push_back(i);
+        }
+
+        size_t vertices = expectedVertexCount(kind);
+        size_t count = indices.size();
+        xs.resize(vertices * count);
+        ys.resize(vertices * count);
+        for (size_t j = 0; j < count; ++j) {
+            size_t o = _offsets[indices[j]];
+            for (size_t v = 0; v < vertices; ++v) {
+                xs[v * count + j] = static_cast<U>(_xs[o + v]);
+                ys[v * count + j] = static_cast<U>(_ys[o + v]);
+            }
+        }
+        return vertices;
+    }
+
+    // Площадь фигуры (те же формулы, что и в классах фигур, но без sqrt/pow там, где они не нужны)
+    double calculateArea(size_t index) const {
+        checkIndex(index);
+        size_t o = _offsets[index];
+        switch (_kinds[index]) {
+            case FigureKind::Triangle: {
+                double cross = dx(o, o + 1) * dy(o, o + 2) - dx(o, o + 2) * dy(o, o + 1);
+                return std::abs(cross) / 2;
+            }
+            case FigureKind::Square:
+                return squaredLength(o, o + 1);
+            case FigureKind::Rectangle:
+                return std::sqrt(squaredLength(o, o + 1) * squaredLength(o, o + 3));
+        }
+        return 0.0;
+    }
+
+    // Центроид фигуры (среднее арифметическое вершин в типе T, как в классах фигур)
+    Point<T> getCentroid(size_t index) const {
+        checkIndex(index);
+        size_t o = _offsets[index];
+        size_t n = _vertexCounts[index];
+        T x = _xs[o];
+        T y = _ys[o];
+        for (size_t v = 1; v < n; ++v) {
+            x += _xs[o + v];
+            y += _ys[o + v];
+        }
+        return Point<T>(static_cast<T>(x / static_cast<T>(n)), static_cast<T>(y / static_cast<T>(n)));
+    }
+
+    // Проверка валидности (те же ограничения, что и в checkValidity() классов фигур;
+    // для целых T - точные предикаты exact.h)
+    bool checkValidity(size_t index) const {
+        checkIndex(index);
+        size_t o = _offsets[index];
+        size_t n = _vertexCounts[index];
+
+        if constexpr (std::is_integral_v<T>) {
+            Point<T> points[4];
+            for (size_t v = 0; v < n; ++v) points[v] = Point<T>(_xs[o + v], _ys[o + v]);
+            switch (_kinds[index]) {
+                case FigureKind::Triangle: return exactTriangleValid(points);
+                case FigureKind::Square: return exactSquareValid(points);
+                case FigureKind::Rectangle: return exactRectangleValid(points);
+            }
+        }
+
+        // Проверка на уникальность точек
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = i + 1; j < n; ++j) {
+                if (Point<T>(_xs[o + i], _ys[o + i]) == Point<T>(_xs[o + j], _ys[o + j])) {
+                    return false;
+                }
+            }
+        }
+
+        if (_kinds[index] == FigureKind::Triangle) {
+            return calculateArea(index) > EPS;
+        }
+
+        double side1 = std::sqrt(squaredLength(o, o + 1));
+        double side2 = std::sqrt(squaredLength(o + 1, o + 2));
+        double side3 = std::sqrt(squaredLength(o + 2, o + 3));
+        double side4 = std::sqrt(squaredLength(o + 3, o));
+
+        if (_kinds[index] == FigureKind::Square) {
+            if (std::abs(side1 - side2) > EPS ||
+                std::abs(side2 - side3) > EPS ||
+                std::abs(side3 - side4) > EPS) {
+                return false;
+            }
+        } else if (std::abs(side1 - side3) > EPS || std::abs(side2 - side4) > EPS) {
+            return false;
+        }
+
+        // Проверка прямого угла через скалярное произведение
+        double dot = dx(o, o + 1) * dx(o, o + 3) + dy(o, o + 1) * dy(o, o + 3);
+        return std::abs(dot) < EPS;
+    }
+
+    // Агрегаты
+    double computeTotalArea() const {
+        double total = 0.0;
+        for (size_t i = 0; i < _kinds.size(); ++i) {
+            total += calculateArea(i);
+        }
+        return total;
+    }
+
+    void computeAreas(std::vector<double>& areas) const {
+        areas.resize(_kinds.size());
+        for (size_t i = 0; i < _kinds.size(); ++i) {
+            areas[i] = calculateArea(i);
+        }
+    }
+
+    void computeCentroids(std::vector<Point<T>>& centroids) const {
+        centroids.resize(_kinds.size());
+        for (size_t i = 0; i < _kinds.size(); ++i) {
+            centroids[i] = getCentroid(i);
+        }
+    }
+
+    size_t countValid() const {
+        size_t valid = 0;
+        for (size_t i = 0; i < _kinds.size(); ++i) {
+            if (checkValidity(i)) ++valid;
+        }
+        return valid;
+    }
+
+    // Обратное преобразование в FigureArray
+    FigureArray<T> toFigureArray() const {
+        FigureArray<T> array;
+        for (size_t i = 0; i < _kinds.size(); ++i) {
+            size_t o = _offsets[i];
+            auto p = [&](size_t v) { return Point<T>(_xs[o + v], _ys[o + v]); };
+            switch (_kinds[i]) {
+                case FigureKind::Triangle:
+                    array.add(std::make_shared<Triangle<T>>(p(0), p(1), p(2)));
+                    break;
+                case FigureKind::Square:
+                    array.add(std::make_shared<Square<T>>(p(0), p(1), p(2), p(3)));
+                    break;
+                case FigureKind::Rectangle:
+                    array.add(std::make_shared<Rectangle<T>>(p(0), p(1), p(2), p(3)));
+                    break;
+            }
+        }
+        return array;
+    }
+};
+
+#endif
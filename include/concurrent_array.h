@@ -0,0 +1,196 @@
+#ifndef CONCURRENT_ARRAY_H
+#define CONCURRENT_ARRAY_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <bit>
+#include <stdexcept>
+#include <algorithm>
+#include <cstddef>
+#include "figure.h"
+#include "array.h"
+#include "parallel.h"
+
+// Массив фигур для одновременного добавления из многих потоков.
+//
+// Хранилище сегментное: сегмент k содержит firstSegmentSize * 2^k ячеек и после выделения
+// не перемещается, поэтому добавление никогда не трогает уже записанные фигуры.
+// Добавление без блокировок: сначала выделяется сегмент под следующий индекс (первым дошедшим
+// до него потоком, compare_exchange), затем индекс резервируется compare_exchange и ячейка
+// помечается готовой. Если выделение бросает исключение, индекс не выдаётся и публикация
+// не останавливается на ячейке, которая никогда не станет готовой.
+// Читатели видят только опубликованный префикс [0, size()): размер продвигается по
+// непрерывной цепочке готовых ячеек, так что в префиксе нет пропусков. Медленный писатель
+// задерживает публикацию следующих за ним фигур, но не блокирует других писателей.
+// Удаления нет: массив рассчитан на приём данных, после которого фигуры переносятся
+// в FigureArray через appendTo.
+template <typename T>
+class ConcurrentFigureArray {
+private:
+    struct Slot {
+        std::shared_ptr<Figure<T>> figure;
+        std::atomic<bool> ready{false};
+    };
+
+    static constexpr size_t firstSegmentBits = 10;
+    static constexpr size_t firstSegmentSize = size_t(1) << firstSegmentBits;
+    static constexpr size_t segmentLimit = 64 - firstSegmentBits;
+
+    // Размер фрагмента для параллельных проходов (как в FigureArray)
+    static constexpr size_t parallelChunkSize = 4096;
+
+    std::atomic<Slot*> _segments[segmentLimit] = {};
+    std::atomic<size_t> _reserved{0};   // Выданные индексы
+    std::atomic<size_t> _published{0};  // Длина готового префикса
+
+    static size_t segmentOf(size_t index) {
+        return static_cast<size_t>(std::bit_width((index >> firstSegmentBits) + 1)) - 1;
+    }
+
+    static size_t segmentStart(size_t segment) {
+        return ((size_t(1) << segment) - 1) << firstSegmentBits;
+    }
+
+    static size_t segmentSize(size_t segment) {
+        return firstSegmentSize << segment;
+    }
+
+    // Сегмент с выделением при первом обращении; проигравший гонку поток освобождает свой
+    Slot* acquireSegment(size_t segment) {
+        Slot* current = _segments[segment].load(std::memory_order_acquire);
+        if (current) return current;
+        Slot* fresh = new Slot[segmentSize(segment)];
+        if (_segments[segment].compare_exchange_strong(current, fresh, std::memory_order_acq_rel)) {
+            return fresh;
+        }
+        delete[] fresh;
+        return current;
+    }
+
+    const Slot& slot(size_t index) const {
+        size_t segment = segmentOf(index);
+        return _segments[segment].load(std::memory_order_acquire)[index - segmentStart(segment)];
+    }
+
+    // Ячейка записана (сегмент мог быть ещё не выделен её писателем)
+    bool isReady(size_t index) const {
+        size_t segment = segmentOf(index);
+        const Slot* slots = _segments[segment].load(std::memory_order_acquire);
+        return slots && slots[index - segmentStart(segment)].ready.load();
+    }
+
+    // Продвижение опубликованного размера по готовым ячейкам. Вызывается каждым писателем
+    // после пометки своей ячейки, поэтому последний завершившийся писатель доводит размер до конца.
+    void publish() {
+        size_t published = _published.load();
+        while (published < _reserved.load() && isReady(published)) {
+            // При неудаче published обновляется текущим значением, и проверка повторяется
+            if (_published.compare_exchange_weak(published, published + 1)) ++published;
+        }
+    }
+
+    // Обход фигур [begin, end) по сегментам
+    template <typename Visit>
+    void scan(size_t begin, size_t end, Visit&& visit) const {
+        while (begin < end) {
+            size_t segment = segmentOf(begin);
+            size_t start = segmentStart(segment);
+            size_t stop = std::min(end, start + segmentSize(segment));
+            const Slot* slots = _segments[segment].load(std::memory_order_acquire);
+            for (size_t i = begin; i < stop; ++i) {
+                visit(i, static_cast<const Figure<T>&>(*slots[i - start].figure));
+            }
+            begin = stop;
+        }
+    }
+
+public:
+    ConcurrentFigureArray() = default;
+
+    ConcurrentFigureArray(const ConcurrentFigureArray& other) = delete;
+    ConcurrentFigureArray& operator=(const ConcurrentFigureArray& other) = delete;
+
+    ~ConcurrentFigureArray() {
+        for (auto& segment : _segments) {
+            delete[] segment.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Предварительное выделение сегментов под capacity фигур (можно вызывать параллельно с add)
+    void reserve(size_t capacity) {
+        for (size_t segment = 0; capacity > 0 && segmentStart(segment) < capacity; ++segment) {
+            acquireSegment(segment);
+        }
+    }
+
+    // Добавление из любого потока; возвращает индекс фигуры
+    size_t add(std::shared_ptr<Figure<T>> figure) {
+        if (!figure) throw std::invalid_argument("Null figure");
+        // Сегмент выделяется до резервирования индекса; при неудаче compare_exchange
+        // index обновляется и сегмент проверяется заново (он мог смениться на следующий)
+        size_t index = _reserved.load();
+        Slot* slots;
+        do {
+            slots = acquireSegment(segmentOf(index));
+        } while (!_reserved.compare_exchange_weak(index, index + 1));
+        Slot& target = slots[index - segmentStart(segmentOf(index))];
+        target.figure = std::move(figure);
+        target.ready.store(true);
+        publish();
+        return index;
+    }
+
+    template <typename Kind, typename... Args>
+    size_t emplace(Args&&... args) {
+        static_assert(std::is_base_of_v<Figure<T>, Kind>, "Kind must derive from Figure<T>");
+        return add(std::make_shared<Kind>(std::forward<Args>(args)...));
+    }
+
+    // Число опубликованных фигур; все индексы меньше него доступны для чтения
+    size_t size() const { return _published.load(std::memory_order_acquire); }
+
+    const Figure<T>& operator[](size_t index) const {
+        if (index >= size()) throw std::out_of_range("Index out of bounds");
+        return *slot(index).figure;
+    }
+
+    // Вызов visit(index, figure) для снимка опубликованного префикса; возвращает его длину
+    template <typename Visit>
+    size_t forEach(Visit visit) const {
+        size_t count = size();
+        scan(0, count, visit);
+        return count;
+    }
+
+    // Агрегаты по снимку префикса: одновременные add не влияют на результат
+    double computeTotalArea() const {
+        double total = 0.0;
+        forEach([&](size_t, const Figure<T>& figure) { total += static_cast<double>(figure); });
+        return total;
+    }
+
+    double computeTotalAreaParallel(ThreadPool& pool = defaultThreadPool()) const {
+        size_t count = size();
+        std::vector<double> partial((count + parallelChunkSize - 1) / parallelChunkSize);
+        pool.parallelFor(partial.size(), [&](size_t chunk) {
+            KahanSum sum;
+            scan(chunk * parallelChunkSize, std::min(count, (chunk + 1) * parallelChunkSize),
+                 [&](size_t, const Figure<T>& figure) { sum.add(static_cast<double>(figure)); });
+            partial[chunk] = sum.result();
+        });
+        return pairwiseSum(partial.data(), partial.size());
+    }
+
+    // Перенос снимка префикса в обычный массив (фигуры разделяются через shared_ptr)
+    size_t appendTo(FigureArray<T>& target) const {
+        size_t count = size();
+        target.reserve(target.size() + count);
+        for (size_t i = 0; i < count; ++i) {
+            target.add(slot(i).figure);
+        }
+        return count;
+    }
+};
+
+#endif
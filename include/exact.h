@@ -0,0 +1,309 @@
+#ifndef EXACT_H
+#define EXACT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <type_traits>
+#include "figure.h"
+
+// Точная арифметика для целочисленных координат.
+//
+// Для целых T площадь, центроид и проверки валидности вычисляются без double и без EPS:
+// удвоенная площадь - целое число (формула шнурования), центроид - пара дробей.
+// Промежуточные значения хранятся в ExactWide<T>: int64_t для типов до 16 бит,
+// 128-битное целое для более широких. Для 64-битных координат результат точен, пока |координаты| < 2^62.
+// Компиляторы без __int128 (MSVC) используют переносимую exact_detail::Int128 из двух 64-битных половин.
+
+namespace exact_detail {
+
+// Знаковое 128-битное целое в дополнительном коде (переполнение - по модулю 2^128, как у __int128)
+class Int128 {
+private:
+    uint64_t _high = 0;
+    uint64_t _low = 0;
+
+    constexpr Int128(uint64_t high, uint64_t low) : _high(high), _low(low) {}
+
+    constexpr bool negative() const { return (_high >> 63) != 0; }
+
+    constexpr Int128 magnitude() const { return negative() ? -*this : *this; }
+
+    // Сравнение как беззнаковых 128-битных чисел (модуль INT128_MIN - 2^127)
+    static constexpr bool lessUnsigned(const Int128& a, const Int128& b) {
+        return a._high != b._high ? a._high < b._high : a._low < b._low;
+    }
+
+    // Преобразование с одним округлением: старшие 64 бита и бит-"липучка" за отброшенные младшие
+    static constexpr double unsignedToDouble(const Int128& value) {
+        if (value._high == 0) return static_cast<double>(value._low);
+        int shift = std::bit_width(value._high);
+        uint64_t top = shift == 64 ? value._high : (value._high << (64 - shift)) | (value._low >> shift);
+        bool sticky = shift == 64 ? value._low != 0 : (value._low << (64 - shift)) != 0;
+        double scale = shift == 64 ? 18446744073709551616.0 : static_cast<double>(uint64_t(1) << shift);
+        return static_cast<double>(top | (sticky ? 1 : 0)) * scale;
+    }
+
+    // Полное произведение 64 x 64 -> 128 через 32-битные половины
+    static constexpr Int128 multiplyWide(uint64_t a, uint64_t b) {
+        uint64_t a0 = a & 0xFFFFFFFFull, a1 = a >> 32;
+        uint64_t b0 = b & 0xFFFFFFFFull, b1 = b >> 32;
+        uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+        uint64_t middle = (p00 >> 32) + (p01 & 0xFFFFFFFFull) + (p10 & 0xFFFFFFFFull);
+        uint64_t low = (middle << 32) | (p00 & 0xFFFFFFFFull);
+        uint64_t high = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+        return Int128(high, low);
+    }
+
+    // Деление модулей сдвигом и вычитанием; делитель не ноль
+    static constexpr void divideMagnitudes(Int128 dividend, Int128 divisor, Int128& quotient, Int128& remainder) {
+        quotient = Int128();
+        remainder = Int128();
+        for (int bit = 127; bit >= 0; --bit) {
+            remainder = Int128((remainder._high << 1) | (remainder._low >> 63), remainder._low << 1);
+            uint64_t next = bit >= 64 ? (dividend._high >> (bit - 64)) & 1 : (dividend._low >> bit) & 1;
+            remainder._low |= next;
+            if (!lessUnsigned(remainder, divisor)) {
+                remainder -= divisor;
+                if (bit >= 64) quotient._high |= uint64_t(1) << (bit - 64);
+                else quotient._low |= uint64_t(1) << bit;
+            }
+        }
+    }
+
+    // Знаковое деление с усечением к нулю (как у встроенных целых)
+    static constexpr void divide(const Int128& a, const Int128& b, Int128& quotient, Int128& remainder) {
+        divideMagnitudes(a.magnitude(), b.magnitude(), quotient, remainder);
+        if (a.negative() != b.negative()) quotient = -quotient;
+        if (a.negative()) remainder = -remainder;
+    }
+
+public:
+    constexpr Int128() = default;
+
+    template <std::integral I>
+    constexpr Int128(I value)
+        : _high(std::is_signed_v<I> && value < 0 ? ~uint64_t(0) : 0),
+          _low(static_cast<uint64_t>(static_cast<std::conditional_t<std::is_signed_v<I>, int64_t, uint64_t>>(value))) {}
+
+    explicit constexpr operator double() const {
+        return negative() ? -unsignedToDouble(-*this) : unsignedToDouble(*this);
+    }
+
+    constexpr Int128 operator-() const {
+        Int128 result(~_high, ~_low);
+        return result += Int128(1);
+    }
+
+    constexpr Int128& operator+=(const Int128& other) {
+        uint64_t low = _low + other._low;
+        _high += other._high + (low < _low ? 1 : 0);
+        _low = low;
+        return *this;
+    }
+
+    constexpr Int128& operator-=(const Int128& other) { return *this += -other; }
+
+    constexpr Int128& operator*=(const Int128& other) {
+        Int128 result = multiplyWide(_low, other._low);
+        result._high += _high * other._low + _low * other._high;
+        return *this = result;
+    }
+
+    constexpr Int128& operator/=(const Int128& other) {
+        Int128 quotient, remainder;
+        divide(*this, other, quotient, remainder);
+        return *this = quotient;
+    }
+
+    constexpr Int128& operator%=(const Int128& other) {
+        Int128 quotient, remainder;
+        divide(*this, other, quotient, remainder);
+        return *this = remainder;
+    }
+
+    friend constexpr Int128 operator+(Int128 a, const Int128& b) { return a += b; }
+    friend constexpr Int128 operator-(Int128 a, const Int128& b) { return a -= b; }
+    friend constexpr Int128 operator*(Int128 a, const Int128& b) { return a *= b; }
+    friend constexpr Int128 operator/(Int128 a, const Int128& b) { return a /= b; }
+    friend constexpr Int128 operator%(Int128 a, const Int128& b) { return a %= b; }
+
+    friend constexpr bool operator==(const Int128& a, const Int128& b) = default;
+
+    friend constexpr std::strong_ordering operator<=>(const Int128& a, const Int128& b) {
+        if (a._high != b._high) {
+            return static_cast<int64_t>(a._high) <=> static_cast<int64_t>(b._high);
+        }
+        return a._low <=> b._low;
+    }
+};
+
+template <std::integral T>
+struct WideFor {
+#if defined(__SIZEOF_INT128__)
+    using type = std::conditional_t<(sizeof(T) <= 2), int64_t, __int128>;
+#else
+    using type = std::conditional_t<(sizeof(T) <= 2), int64_t, Int128>;
+#endif
+};
+
+} // namespace exact_detail
+
+template <std::integral T>
+using ExactWide = typename exact_detail::WideFor<T>::type;
+
+// Несократимая дробь со знаменателем > 0
+template <std::integral T>
+struct ExactFraction {
+    ExactWide<T> numerator = 0;
+    ExactWide<T> denominator = 1;
+
+    constexpr ExactFraction() = default;
+
+    constexpr ExactFraction(ExactWide<T> num, ExactWide<T> den) : numerator(num), denominator(den) {
+        if (denominator < 0) {
+            numerator = -numerator;
+            denominator = -denominator;
+        }
+        ExactWide<T> a = numerator < 0 ? -numerator : numerator;
+        ExactWide<T> b = denominator;
+        while (b != 0) {
+            ExactWide<T> r = a % b;
+            a = b;
+            b = r;
+        }
+        if (a > 1) {
+            numerator /= a;
+            denominator /= a;
+        }
+    }
+
+    bool operator==(const ExactFraction& other) const = default;
+
+    constexpr bool isInteger() const { return denominator == 1; }
+
+    double toDouble() const {
+        return static_cast<double>(numerator) / static_cast<double>(denominator);
+    }
+};
+
+// Точка с рациональными координатами
+template <std::integral T>
+struct ExactPoint {
+    ExactFraction<T> x;
+    ExactFraction<T> y;
+
+    bool operator==(const ExactPoint& other) const = default;
+
+    Point<double> toDouble() const {
+        return Point<double>(x.toDouble(), y.toDouble());
+    }
+};
+
+namespace exact_detail {
+
+template <std::integral T>
+constexpr ExactWide<T> dx(const Point<T>& from, const Point<T>& to) {
+    return static_cast<ExactWide<T>>(to.getX()) - static_cast<ExactWide<T>>(from.getX());
+}
+
+template <std::integral T>
+constexpr ExactWide<T> dy(const Point<T>& from, const Point<T>& to) {
+    return static_cast<ExactWide<T>>(to.getY()) - static_cast<ExactWide<T>>(from.getY());
+}
+
+template <std::integral T>
+constexpr ExactWide<T> squaredLength(const Point<T>& from, const Point<T>& to) {
+    return dx(from, to) * dx(from, to) + dy(from, to) * dy(from, to);
+}
+
+} // namespace exact_detail
+
+// Удвоенная площадь многоугольника (модуль суммы векторных произведений относительно вершины 0)
+template <std::integral T>
+constexpr ExactWide<T> exactTwiceArea(const Point<T>* points, size_t count) {
+    using exact_detail::dx;
+    using exact_detail::dy;
+    ExactWide<T> sum = 0;
+    for (size_t v = 2; v < count; ++v) {
+        sum += dx(points[0], points[v - 1]) * dy(points[0], points[v]) -
+               dx(points[0], points[v]) * dy(points[0], points[v - 1]);
+    }
+    return sum < 0 ? -sum : sum;
+}
+
+// Центроид вершин (среднее арифметическое) без округления
+template <std::integral T>
+constexpr ExactPoint<T> exactCentroid(const Point<T>* points, size_t count) {
+    ExactWide<T> x = 0;
+    ExactWide<T> y = 0;
+    for (size_t v = 0; v < count; ++v) {
+        x += points[v].getX();
+        y += points[v].getY();
+    }
+    ExactWide<T> n = static_cast<ExactWide<T>>(count);
+    return ExactPoint<T>{ExactFraction<T>(x, n), ExactFraction<T>(y, n)};
+}
+
+// Точные проверки валидности (те же ограничения, что и checkValidity(), без EPS)
+template <std::integral T>
+constexpr bool exactDistinct(const Point<T>* points, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = i + 1; j < count; ++j) {
+            if (points[i].getX() == points[j].getX() && points[i].getY() == points[j].getY()) return false;
+        }
+    }
+    return true;
+}
+
+template <std::integral T>
+constexpr bool exactTriangleValid(const Point<T>* points) {
+    return exactDistinct(points, 3) && exactTwiceArea(points, 3) != 0;
+}
+
+// Прямой угол при вершине 0 четырёхугольника
+template <std::integral T>
+constexpr bool exactRightAngle(const Point<T>* points) {
+    using exact_detail::dx;
+    using exact_detail::dy;
+    return dx(points[0], points[1]) * dx(points[0], points[3]) + dy(points[0], points[1]) * dy(points[0], points[3]) == 0;
+}
+
+template <std::integral T>
+constexpr bool exactSquareValid(const Point<T>* points) {
+    using exact_detail::squaredLength;
+    if (!exactDistinct(points, 4)) return false;
+    ExactWide<T> side = squaredLength(points[0], points[1]);
+    return squaredLength(points[1], points[2]) == side &&
+           squaredLength(points[2], points[3]) == side &&
+           squaredLength(points[3], points[0]) == side &&
+           exactRightAngle(points);
+}
+
+template <std::integral T>
+constexpr bool exactRectangleValid(const Point<T>* points) {
+    using exact_detail::squaredLength;
+    if (!exactDistinct(points, 4)) return false;
+    return squaredLength(points[0], points[1]) == squaredLength(points[2], points[3]) &&
+           squaredLength(points[1], points[2]) == squaredLength(points[3], points[0]) &&
+           exactRightAngle(points);
+}
+
+// Точные результаты для любой фигуры с целыми координатами
+template <std::integral T>
+ExactWide<T> exactTwiceArea(const Figure<T>& figure) {
+    Point<T> points[4];
+    for (size_t v = 0; v < figure.vertexCount(); ++v) points[v] = figure.getVertex(v);
+    return exactTwiceArea(points, figure.vertexCount());
+}
+
+template <std::integral T>
+ExactPoint<T> exactCentroid(const Figure<T>& figure) {
+    Point<T> points[4];
+    for (size_t v = 0; v < figure.vertexCount(); ++v) points[v] = figure.getVertex(v);
+    return exactCentroid(points, figure.vertexCount());
+}
+
+#endif
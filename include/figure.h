@@ -3,8 +3,90 @@
 
 #include <iostream>
 #include <memory>
+#include <stdexcept>
+#include <algorithm>
+#include <array>
 #include "points.h"
-      
+
+// Вид фигуры (используется для диспетчеризации без dynamic_cast)
+enum class FigureKind : unsigned char {
+    Triangle,
+    Square,
+    Rectangle
+};
+
+// Ограничивающий прямоугольник со сторонами, параллельными осям
+template <Scalar T>
+struct BoundingBox {
+    T minX = T(0);
+    T minY = T(0);
+    T maxX = T(0);
+    T maxY = T(0);
+
+    bool contains(const Point<T>& point) const {
+        return point.getX() >= minX && point.getX() <= maxX &&
+               point.getY() >= minY && point.getY() <= maxY;
+    }
+
+    bool intersects(const BoundingBox& other) const {
+        return minX <= other.maxX && other.minX <= maxX &&
+               minY <= other.maxY && other.minY <= maxY;
+    }
+
+    // Расширение прямоугольника до включения точки
+    void expand(const Point<T>& point) {
+        minX = std::min(minX, point.getX());
+        minY = std::min(minY, point.getY());
+        maxX = std::max(maxX, point.getX());
+        maxY = std::max(maxY, point.getY());
+    }
+
+    void expand(const BoundingBox& other) {
+        minX = std::min(minX, other.minX);
+        minY = std::min(minY, other.minY);
+        maxX = std::max(maxX, other.maxX);
+        maxY = std::max(maxY, other.maxY);
+    }
+};
+
+// Сводные показатели массива (FigureArray::stats, StaticFigureArray::stats)
+template <Scalar T>
+struct FigureArrayStats {
+    size_t count = 0;
+    std::array<size_t, 3> kindCounts{};  // Число фигур каждого вида, индекс - FigureKind
+    double totalArea = 0.0;              // Сумма площадей с компенсацией
+    BoundingBox<T> bounds;               // Общий ограничивающий прямоугольник (нулевой для пустого массива)
+
+    size_t countOf(FigureKind kind) const { return kindCounts[static_cast<size_t>(kind)]; }
+};
+
+// Счётчик ссылок для IntrusivePtr (ownership.h). Неатомарный: фигуру с интрузивным владением
+// нельзя захватывать и освобождать из нескольких потоков одновременно. При копировании
+// фигуры счётчик не копируется - копия начинает без владельцев.
+class IntrusiveRefCount {
+private:
+    template <typename F>
+    friend class IntrusivePtr;
+
+    mutable unsigned _count = 0;
+
+public:
+    IntrusiveRefCount() = default;
+    IntrusiveRefCount(const IntrusiveRefCount&) {}
+    IntrusiveRefCount& operator=(const IntrusiveRefCount&) { return *this; }
+};
+
+// Кэш площади, центроида и ограничивающего прямоугольника фигуры
+template <Scalar T>
+struct FigureCache {
+    bool hasArea = false;
+    bool hasCentroid = false;
+    bool hasBoundingBox = false;
+    double area = 0.0;
+    Point<T> centroid;
+    BoundingBox<T> boundingBox;
+};
+
 // Шаблонный абстрактный класс Figure
 template <Scalar T>
 class Figure {
@@ -14,9 +96,41 @@ class Figure {
     template <Scalar U>
     friend std::istream& operator>>(std::istream& is, Figure<U>& fig);
 
+    template <typename F>
+    friend class IntrusivePtr;
+
+private:
+    IntrusiveRefCount _references;
+
+    // Кэш выделяется при включении и хранится отдельно, так что фигура без кэша платит
+    // только за указатель. Кэш не синхронизирован: одну фигуру с включённым кэшем
+    // нельзя читать из нескольких потоков.
+    std::unique_ptr<FigureCache<T>> _cache;
+
 protected:
     Figure() = default;
 
+    // Копия получает состояние кэша оригинала, перемещение забирает кэш
+    Figure(const Figure& other)
+        : _cache(other._cache ? std::make_unique<FigureCache<T>>(*other._cache) : nullptr) {}
+
+    Figure(Figure&& other) noexcept : _cache(std::move(other._cache)) {}
+
+    Figure& operator=(const Figure& other) {
+        if (this != &other) {
+            _cache = other._cache ? std::make_unique<FigureCache<T>>(*other._cache) : nullptr;
+        }
+        return *this;
+    }
+
+    Figure& operator=(Figure&& other) noexcept {
+        _cache = std::move(other._cache);
+        return *this;
+    }
+
+    // Сброс кэша - вызывается производными классами при изменении вершин
+    void invalidateCache();
+
 public:
     virtual ~Figure() = default;
     
@@ -31,12 +145,85 @@ public:
     
     // Методы для проверки
     virtual bool checkValidity() const = 0;
+
+    // Методы для доступа к вершинам
+    virtual FigureKind kind() const = 0;
+    virtual size_t vertexCount() const = 0;
+    virtual Point<T> getVertex(size_t index) const = 0;
     
     // Операторы сравнения
     virtual bool operator==(const Figure<T>& otherFig) const = 0;
     virtual bool operator!=(const Figure<T>& otherFig) const = 0;
+
+    // Кэшируемые значения (кэш по умолчанию выключен, тогда значения вычисляются каждый раз)
+    void setCaching(bool enabled);
+    bool isCaching() const;
+    double area() const;
+    Point<T> centroid() const;
+    BoundingBox<T> boundingBox() const;
 };
 
+// Сброс кэша
+template <Scalar T>
+void Figure<T>::invalidateCache() {
+    if (_cache) *_cache = FigureCache<T>();
+}
+
+// Включение/выключение кэша
+template <Scalar T>
+void Figure<T>::setCaching(bool enabled) {
+    if (enabled) {
+        _cache = std::make_unique<FigureCache<T>>();
+    } else {
+        _cache.reset();
+    }
+}
+
+template <Scalar T>
+bool Figure<T>::isCaching() const {
+    return _cache != nullptr;
+}
+
+// Площадь с кэшем
+template <Scalar T>
+double Figure<T>::area() const {
+    if (!_cache) return calculateArea();
+    if (!_cache->hasArea) {
+        _cache->area = calculateArea();
+        _cache->hasArea = true;
+    }
+    return _cache->area;
+}
+
+// Центроид с кэшем
+template <Scalar T>
+Point<T> Figure<T>::centroid() const {
+    if (!_cache) return getCentroid();
+    if (!_cache->hasCentroid) {
+        _cache->centroid = getCentroid();
+        _cache->hasCentroid = true;
+    }
+    return _cache->centroid;
+}
+
+// Ограничивающий прямоугольник с кэшем
+template <Scalar T>
+BoundingBox<T> Figure<T>::boundingBox() const {
+    if (_cache && _cache->hasBoundingBox) return _cache->boundingBox;
+
+    Point<T> first = getVertex(0);
+    BoundingBox<T> box{first.getX(), first.getY(), first.getX(), first.getY()};
+    for (size_t i = 1; i < vertexCount(); ++i) {
+        box.expand(getVertex(i));
+    }
+
+    if (_cache) {
+        _cache->boundingBox = box;
+        _cache->hasBoundingBox = true;
+    }
+    return box;
+}
+
 template <Scalar T>
 std::ostream& operator<<(std::ostream& os, const Figure<T>& figure) {
     figure.output(os);
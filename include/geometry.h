@@ -0,0 +1,211 @@
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <cstddef>
+#include <type_traits>
+#include "points.h"
+#include "exact.h"
+
+// Геометрия треугольника, квадрата и прямоугольника над массивом вершин.
+//
+// Все функции constexpr: их используют методы Triangle/Square/Rectangle во время выполнения
+// и значимые типы TriangleShape/SquareShape/RectangleShape во время компиляции, поэтому
+// формулы записаны в одном месте. Для целых T действует точный путь из exact.h.
+// При вычислении во время компиляции квадратный корень берётся методом Ньютона и может
+// отличаться от std::sqrt в последнем двоичном знаке.
+
+namespace geometry_detail {
+
+constexpr double absolute(double value) {
+    return value < 0 ? -value : value;
+}
+
+// std::sqrt во время выполнения, метод Ньютона во время компиляции
+constexpr double constexprSqrt(double value) {
+    if (!std::is_constant_evaluated()) return std::sqrt(value);
+    if (!(value >= 0)) return std::numeric_limits<double>::quiet_NaN();
+    if (value == 0 || value == std::numeric_limits<double>::infinity()) return value;
+
+    // Начиная сверху, последовательность убывает до корня; останавливаемся, когда убывание прекратилось
+    double x = value > 1 ? value : 1;
+    while (true) {
+        double next = (x + value / x) / 2;
+        if (next >= x) return x;
+        x = next;
+    }
+}
+
+// Длина стороны: разность в T, квадрат и сумма в double (как std::pow(d, 2))
+template <Scalar T>
+constexpr double sideLength(const Point<T>& from, const Point<T>& to) {
+    double dx = static_cast<double>(to.getX() - from.getX());
+    double dy = static_cast<double>(to.getY() - from.getY());
+    return constexprSqrt(dx * dx + dy * dy);
+}
+
+// Скалярное произведение сторон при вершине 0 четырёхугольника (вычисляется в T)
+template <Scalar T>
+constexpr double dotAtFirstVertex(const std::array<Point<T>, 4>& points) {
+    return (points[1].getX() - points[0].getX()) * (points[3].getX() - points[0].getX()) +
+           (points[1].getY() - points[0].getY()) * (points[3].getY() - points[0].getY());
+}
+
+// Все вершины различны (сравнение Point::operator== с допуском EPS)
+template <Scalar T, size_t N>
+constexpr bool distinctVertices(const std::array<Point<T>, N>& points) {
+    for (size_t i = 0; i < N; ++i) {
+        for (size_t j = i + 1; j < N; ++j) {
+            if (points[i] == points[j]) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace geometry_detail
+
+// Центроид вершин (среднее арифметическое, деление в T)
+template <Scalar T, size_t N>
+constexpr Point<T> vertexCentroid(const std::array<Point<T>, N>& points) {
+    decltype(T() + T()) x = points[0].getX();
+    decltype(T() + T()) y = points[0].getY();
+    for (size_t i = 1; i < N; ++i) {
+        x += points[i].getX();
+        y += points[i].getY();
+    }
+    return Point<T>(static_cast<T>(x / static_cast<int>(N)), static_cast<T>(y / static_cast<int>(N)));
+}
+
+// Площадь треугольника (формула Герона; для целых T - точная формула шнурования)
+template <Scalar T>
+constexpr double triangleArea(const std::array<Point<T>, 3>& points) {
+    if constexpr (std::is_integral_v<T>) {
+        return static_cast<double>(exactTwiceArea(points.data(), 3)) / 2;
+    } else {
+        using geometry_detail::sideLength;
+        double a = sideLength(points[0], points[1]);
+        double b = sideLength(points[1], points[2]);
+        double c = sideLength(points[2], points[0]);
+        double s = (a + b + c) / 2;
+        return geometry_detail::constexprSqrt(s * (s - a) * (s - b) * (s - c));
+    }
+}
+
+// Площадь квадрата (квадрат стороны)
+template <Scalar T>
+constexpr double squareArea(const std::array<Point<T>, 4>& points) {
+    if constexpr (std::is_integral_v<T>) {
+        return static_cast<double>(exactTwiceArea(points.data(), 4)) / 2;
+    } else {
+        double side = geometry_detail::sideLength(points[0], points[1]);
+        return side * side;
+    }
+}
+
+// Площадь прямоугольника (произведение смежных сторон)
+template <Scalar T>
+constexpr double rectangleArea(const std::array<Point<T>, 4>& points) {
+    if constexpr (std::is_integral_v<T>) {
+        return static_cast<double>(exactTwiceArea(points.data(), 4)) / 2;
+    } else {
+        using geometry_detail::sideLength;
+        return sideLength(points[0], points[1]) * sideLength(points[0], points[3]);
+    }
+}
+
+// Треугольник: вершины различны и не лежат на одной прямой
+template <Scalar T>
+constexpr bool triangleValid(const std::array<Point<T>, 3>& points) {
+    if constexpr (std::is_integral_v<T>) {
+        return exactTriangleValid(points.data());
+    } else {
+        return geometry_detail::distinctVertices(points) && triangleArea(points) > EPS;
+    }
+}
+
+// Квадрат: вершины различны, все стороны равны, угол при вершине 0 прямой
+template <Scalar T>
+constexpr bool squareValid(const std::array<Point<T>, 4>& points) {
+    if constexpr (std::is_integral_v<T>) {
+        return exactSquareValid(points.data());
+    } else {
+        using geometry_detail::absolute;
+        using geometry_detail::sideLength;
+        if (!geometry_detail::distinctVertices(points)) return false;
+        double side1 = sideLength(points[0], points[1]);
+        double side2 = sideLength(points[1], points[2]);
+        double side3 = sideLength(points[2], points[3]);
+        double side4 = sideLength(points[3], points[0]);
+        if (absolute(side1 - side2) > EPS || absolute(side2 - side3) > EPS || absolute(side3 - side4) > EPS) {
+            return false;
+        }
+        return absolute(geometry_detail::dotAtFirstVertex(points)) < EPS;
+    }
+}
+
+// Прямоугольник: вершины различны, противоположные стороны равны, угол при вершине 0 прямой
+template <Scalar T>
+constexpr bool rectangleValid(const std::array<Point<T>, 4>& points) {
+    if constexpr (std::is_integral_v<T>) {
+        return exactRectangleValid(points.data());
+    } else {
+        using geometry_detail::absolute;
+        using geometry_detail::sideLength;
+        if (!geometry_detail::distinctVertices(points)) return false;
+        double side1 = sideLength(points[0], points[1]);
+        double side2 = sideLength(points[1], points[2]);
+        double side3 = sideLength(points[2], points[3]);
+        double side4 = sideLength(points[3], points[0]);
+        if (absolute(side1 - side3) > EPS || absolute(side2 - side4) > EPS) {
+            return false;
+        }
+        return absolute(geometry_detail::dotAtFirstVertex(points)) < EPS;
+    }
+}
+
+// Значимые типы фигур для вычислений во время компиляции, например:
+//   constexpr RectangleShape<int> plate(Point<int>(0, 0), Point<int>(40, 0), Point<int>(40, 25), Point<int>(0, 25));
+//   static_assert(plate.isValid() && plate.area() == 1000);
+// Фигура Triangle/Square/Rectangle строится из такого значения явным конструктором.
+
+template <Scalar T>
+struct TriangleShape {
+    std::array<Point<T>, 3> points;
+
+    constexpr TriangleShape() : points{Point<T>(T(0), T(0)), Point<T>(T(1), T(0)), Point<T>(T(0), T(1))} {}
+    constexpr TriangleShape(Point<T> a, Point<T> b, Point<T> c) : points{a, b, c} {}
+
+    constexpr double area() const { return triangleArea(points); }
+    constexpr Point<T> centroid() const { return vertexCentroid(points); }
+    constexpr bool isValid() const { return triangleValid(points); }
+};
+
+template <Scalar T>
+struct SquareShape {
+    std::array<Point<T>, 4> points;
+
+    constexpr SquareShape()
+        : points{Point<T>(T(0), T(0)), Point<T>(T(1), T(0)), Point<T>(T(1), T(1)), Point<T>(T(0), T(1))} {}
+    constexpr SquareShape(Point<T> a, Point<T> b, Point<T> c, Point<T> d) : points{a, b, c, d} {}
+
+    constexpr double area() const { return squareArea(points); }
+    constexpr Point<T> centroid() const { return vertexCentroid(points); }
+    constexpr bool isValid() const { return squareValid(points); }
+};
+
+template <Scalar T>
+struct RectangleShape {
+    std::array<Point<T>, 4> points;
+
+    constexpr RectangleShape()
+        : points{Point<T>(T(0), T(0)), Point<T>(T(2), T(0)), Point<T>(T(2), T(1)), Point<T>(T(0), T(1))} {}
+    constexpr RectangleShape(Point<T> a, Point<T> b, Point<T> c, Point<T> d) : points{a, b, c, d} {}
+
+    constexpr double area() const { return rectangleArea(points); }
+    constexpr Point<T> centroid() const { return vertexCentroid(points); }
+    constexpr bool isValid() const { return rectangleValid(points); }
+};
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Класс MappedFile - файл, отображённый в память только для чтения.
+// Страницы берутся из страничного кэша ОС, поэтому несколько процессов,
+// отображающих один файл, используют одну и ту же физическую память.
+class MappedFile {
+private:
+    const char* _data = nullptr;
+    size_t _size = 0;
+#ifdef _WIN32
+    HANDLE _file = INVALID_HANDLE_VALUE;
+    HANDLE _mapping = nullptr;
+#endif
+
+    void close() noexcept {
+#ifdef _WIN32
+        if (_data) UnmapViewOfFile(_data);
+        if (_mapping) CloseHandle(_mapping);
+        if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+        _mapping = nullptr;
+        _file = INVALID_HANDLE_VALUE;
+#else
+        if (_data) munmap(const_cast<char*>(_data), _size);
+#endif
+        _data = nullptr;
+        _size = 0;
+    }
+
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        _file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (_file == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot open file: " + path);
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(_file, &size)) {
+            close();
+            throw std::runtime_error("Cannot get file size: " + path);
+        }
+        _size = static_cast<size_t>(size.QuadPart);
+        if (_size == 0) return;
+        _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (_mapping) {
+            _data = static_cast<const char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+        if (!_data) {
+            close();
+            throw std::runtime_error("Cannot map file: " + path);
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Cannot open file: " + path);
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot get file size: " + path);
+        }
+        _size = static_cast<size_t>(info.st_size);
+        if (_size != 0) {
+            void* data = ::mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+            if (data == MAP_FAILED) {
+                ::close(fd);
+                _size = 0;
+                throw std::runtime_error("Cannot map file: " + path);
+            }
+            _data = static_cast<const char*>(data);
+        }
+        // Отображение остаётся действительным после закрытия дескриптора
+        ::close(fd);
+#endif
+    }
+
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    MappedFile(MappedFile&& other) noexcept
+        : _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0))
+#ifdef _WIN32
+        , _file(std::exchange(other._file, INVALID_HANDLE_VALUE)), _mapping(std::exchange(other._mapping, nullptr))
+#endif
+    {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+#ifdef _WIN32
+            _file = std::exchange(other._file, INVALID_HANDLE_VALUE);
+            _mapping = std::exchange(other._mapping, nullptr);
+#endif
+        }
+        return *this;
+    }
+
+    ~MappedFile() {
+        close();
+    }
+
+    const char* data() const { return _data; }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+};
+
+#endif
@@ -0,0 +1,261 @@
+#ifndef MAPPED_VIEW_H
+#define MAPPED_VIEW_H
+
+#include <array>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include "figure.h"
+#include "geometry.h"
+#include "binary_io.h"
+#include "batch_area.h"
+#include "mapped_file.h"
+#include "parallel.h"
+
+// Шаблонный класс MappedFigureView - представление файла двоичного формата (binary_io.h)
+// только для чтения. Фигуры не копируются: вершины, площади и центроиды вычисляются
+// прямо по отображённым страницам, поэтому открытие файла стоит O(число фрагментов).
+template <Scalar T>
+class MappedFigureView {
+private:
+    // Фрагмент файла: фигуры [first, first + count) одного вида
+    struct Chunk {
+        FigureKind kind;
+        size_t vertexCount;
+        size_t count;
+        size_t first;
+        const T* xs;  // xs[v * count + j]
+        const T* ys;
+    };
+
+    static constexpr size_t parallelChunkSize = 4096;
+
+    MappedFile _file;
+    std::vector<Chunk> _chunks;
+    std::vector<size_t> _chunkFirst;  // Индексы первых фигур фрагментов (для двоичного поиска)
+    size_t _size = 0;
+
+    void parse(const char* data, size_t bytes) {
+        if (bytes < figure_binary::fileHeaderSize) throw std::runtime_error("Truncated figure file");
+        if (reinterpret_cast<uintptr_t>(data) % 8 != 0) {
+            throw std::invalid_argument("Figure data must be 8-byte aligned");
+        }
+
+        figure_binary::FileHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        figure_binary::validateHeader<T>(header);
+
+        size_t position = figure_binary::fileHeaderSize;
+        for (;;) {
+            if (bytes - position < figure_binary::chunkHeaderSize) throw std::runtime_error("Truncated figure file");
+            figure_binary::ChunkHeader chunk;
+            std::memcpy(&chunk, data + position, sizeof(chunk));
+            position += figure_binary::chunkHeaderSize;
+            if (chunk.kind == figure_binary::endKind) break;
+
+            figure_binary::validateChunk(chunk, sizeof(T));
+            if (bytes - position < chunk.payloadBytes) throw std::runtime_error("Truncated figure file");
+
+            const T* xs = reinterpret_cast<const T*>(data + position);
+            _chunks.push_back(Chunk{static_cast<FigureKind>(chunk.kind), chunk.vertexCount, chunk.count,
+                                    _size, xs, xs + size_t(chunk.vertexCount) * chunk.count});
+            _chunkFirst.push_back(_size);
+            _size += chunk.count;
+            position += chunk.payloadBytes;
+        }
+        if (_size != header.figureCount) throw std::runtime_error("Figure count does not match file header");
+    }
+
+    // Фрагмент, содержащий фигуру index, и её позиция в нём
+    std::pair<const Chunk*, size_t> locate(size_t index) const {
+        if (index >= _size) throw std::out_of_range("Index out of bounds");
+        auto it = std::upper_bound(_chunkFirst.begin(), _chunkFirst.end(), index);
+        const Chunk& chunk = _chunks[static_cast<size_t>(it - _chunkFirst.begin()) - 1];
+        return {&chunk, index - chunk.first};
+    }
+
+    // Вершины фигуры j фрагмента в порядке хранения
+    template <size_t N>
+    static std::array<Point<T>, N> verticesOf(const Chunk& c, size_t j) {
+        std::array<Point<T>, N> points;
+        for (size_t v = 0; v < N; ++v) {
+            points[v] = Point<T>(c.xs[v * c.count + j], c.ys[v * c.count + j]);
+        }
+        return points;
+    }
+
+    // Формулы geometry.h, как в calculateArea() классов фигур: результаты совпадают побитно
+    static double areaOf(const Chunk& c, size_t j) {
+        switch (c.kind) {
+            case FigureKind::Triangle:
+                return triangleArea(verticesOf<3>(c, j));
+            case FigureKind::Square:
+                return squareArea(verticesOf<4>(c, j));
+            case FigureKind::Rectangle:
+                return rectangleArea(verticesOf<4>(c, j));
+        }
+        return 0.0;
+    }
+
+    // Среднее арифметическое вершин в типе T, как в классах фигур
+    static Point<T> centroidOf(const Chunk& c, size_t j) {
+        T x = c.xs[j];
+        T y = c.ys[j];
+        for (size_t v = 1; v < c.vertexCount; ++v) {
+            x += c.xs[v * c.count + j];
+            y += c.ys[v * c.count + j];
+        }
+        T n = static_cast<T>(c.vertexCount);
+        return Point<T>(static_cast<T>(x / n), static_cast<T>(y / n));
+    }
+
+    // Обход фигур [begin, end) по фрагментам: visit(chunk, j, index)
+    template <typename Visit>
+    void forRange(size_t begin, size_t end, Visit visit) const {
+        if (begin >= end) return;
+        auto it = std::upper_bound(_chunkFirst.begin(), _chunkFirst.end(), begin);
+        for (size_t c = static_cast<size_t>(it - _chunkFirst.begin()) - 1; c < _chunks.size(); ++c) {
+            const Chunk& chunk = _chunks[c];
+            if (chunk.first >= end) break;
+            size_t from = std::max(begin, chunk.first) - chunk.first;
+            size_t to = std::min(end, chunk.first + chunk.count) - chunk.first;
+            for (size_t j = from; j < to; ++j) {
+                visit(chunk, j, chunk.first + j);
+            }
+        }
+    }
+
+    size_t parallelChunkCount() const {
+        return (_size + parallelChunkSize - 1) / parallelChunkSize;
+    }
+
+public:
+    // Отображение файла в память
+    explicit MappedFigureView(const std::string& path) : _file(path) {
+        parse(_file.data(), _file.size());
+    }
+
+    // Представление уже загруженного буфера (не владеет им; адрес должен быть выровнен на 8 байт)
+    MappedFigureView(const void* data, size_t bytes) {
+        parse(static_cast<const char*>(data), bytes);
+    }
+
+    MappedFigureView(const MappedFigureView& other) = delete;
+    MappedFigureView& operator=(const MappedFigureView& other) = delete;
+    MappedFigureView(MappedFigureView&& other) noexcept = default;
+    MappedFigureView& operator=(MappedFigureView&& other) noexcept = default;
+
+    size_t size() const { return _size; }
+    size_t chunkCount() const { return _chunks.size(); }
+
+    FigureKind kind(size_t index) const {
+        return locate(index).first->kind;
+    }
+
+    size_t vertexCount(size_t index) const {
+        return locate(index).first->vertexCount;
+    }
+
+    Point<T> getVertex(size_t index, size_t vertex) const {
+        auto [chunk, j] = locate(index);
+        if (vertex >= chunk->vertexCount) throw std::out_of_range("Vertex index out of bounds");
+        return Point<T>(chunk->xs[vertex * chunk->count + j], chunk->ys[vertex * chunk->count + j]);
+    }
+
+    double calculateArea(size_t index) const {
+        auto [chunk, j] = locate(index);
+        return areaOf(*chunk, j);
+    }
+
+    Point<T> getCentroid(size_t index) const {
+        auto [chunk, j] = locate(index);
+        return centroidOf(*chunk, j);
+    }
+
+    // Агрегаты: побитно совпадают с FigureArray для тех же фигур в том же порядке (FigureOrder::Preserve)
+    double computeTotalArea() const {
+        double total = 0.0;
+        for (const Chunk& chunk : _chunks) {
+            for (size_t j = 0; j < chunk.count; ++j) {
+                total += areaOf(chunk, j);
+            }
+        }
+        return total;
+    }
+
+    void computeAreas(std::vector<double>& areas) const {
+        areas.resize(_size);
+        forRange(0, _size, [&](const Chunk& chunk, size_t j, size_t index) {
+            areas[index] = areaOf(chunk, j);
+        });
+    }
+
+    void computeCentroids(std::vector<Point<T>>& centroids) const {
+        centroids.resize(_size);
+        forEachCentroid([&](size_t index, const Point<T>& centroid) {
+            centroids[index] = centroid;
+        });
+    }
+
+    // Обход центроидов без промежуточного массива: visit(index, centroid)
+    template <typename Visit>
+    void forEachCentroid(Visit visit) const {
+        forRange(0, _size, [&](const Chunk& chunk, size_t j, size_t index) {
+            visit(index, centroidOf(chunk, j));
+        });
+    }
+
+    // Площади по формуле шнурования векторным ядром прямо по плоскостям файла
+    // (для float и double без копирования координат); с computeAreas совпадают в пределах округления
+    void computeAreasBatch(std::vector<double>& areas, SimdLevel level = detectSimdLevel()) const {
+        using Lane = std::conditional_t<std::is_same_v<T, float>, float, double>;
+
+        areas.resize(_size);
+        std::vector<Lane> xs, ys, packed;
+        for (const Chunk& chunk : _chunks) {
+            const Lane* px;
+            const Lane* py;
+            if constexpr (std::is_same_v<T, Lane>) {
+                px = chunk.xs;
+                py = chunk.ys;
+            } else {
+                size_t values = chunk.vertexCount * chunk.count;
+                xs.assign(chunk.xs, chunk.xs + values);
+                ys.assign(chunk.ys, chunk.ys + values);
+                px = xs.data();
+                py = ys.data();
+            }
+            packed.resize(chunk.count);
+            batchShoelaceArea(px, py, chunk.vertexCount, chunk.count, packed.data(), level);
+            std::copy(packed.begin(), packed.end(), areas.begin() + static_cast<std::ptrdiff_t>(chunk.first));
+        }
+    }
+
+    // Параллельные версии (те же фрагменты и порядок суммирования, что и в FigureArray)
+    double computeTotalAreaParallel(ThreadPool& pool = defaultThreadPool()) const {
+        std::vector<double> partial(parallelChunkCount());
+        pool.parallelFor(partial.size(), [&](size_t part) {
+            KahanSum sum;
+            forRange(part * parallelChunkSize, std::min(_size, (part + 1) * parallelChunkSize),
+                     [&](const Chunk& chunk, size_t j, size_t) { sum.add(areaOf(chunk, j)); });
+            partial[part] = sum.result();
+        });
+        return pairwiseSum(partial.data(), partial.size());
+    }
+
+    std::vector<Point<T>> computeCentroidsParallel(ThreadPool& pool = defaultThreadPool()) const {
+        std::vector<Point<T>> centroids(_size);
+        pool.parallelFor(parallelChunkCount(), [&](size_t part) {
+            forRange(part * parallelChunkSize, std::min(_size, (part + 1) * parallelChunkSize),
+                     [&](const Chunk& chunk, size_t j, size_t index) { centroids[index] = centroidOf(chunk, j); });
+        });
+        return centroids;
+    }
+};
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef ORDERING_H
+#define ORDERING_H
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <cstddef>
+#include "figure.h"
+#include "parallel.h"
+
+// Ключи и вспомогательные функции для упорядочивания FigureArray и StaticFigureArray
+// (sortBy, topK, nthElement). Ключ - функция const Figure<T>& -> double. Ключи вычисляются
+// один раз в массив пар (ключ, индекс), сортируется этот массив, затем ячейки массива
+// переставляются на месте.
+
+// Готовые ключи
+struct AreaKey {
+    template <Scalar T>
+    double operator()(const Figure<T>& figure) const { return static_cast<double>(figure); }
+};
+
+struct CentroidXKey {
+    template <Scalar T>
+    double operator()(const Figure<T>& figure) const { return static_cast<double>(figure.centroid().getX()); }
+};
+
+struct CentroidYKey {
+    template <Scalar T>
+    double operator()(const Figure<T>& figure) const { return static_cast<double>(figure.centroid().getY()); }
+};
+
+enum class SortOrder {
+    Ascending,
+    Descending
+};
+
+namespace ordering_detail {
+
+struct KeyedIndex {
+    double key = 0.0;
+    size_t index = 0;
+};
+
+// Полный порядок: NaN после всех чисел (в том числе +inf), затем по ключу,
+// при равенстве - по исходному индексу (результат как у устойчивой сортировки)
+inline bool keyedLess(const KeyedIndex& a, const KeyedIndex& b) {
+    bool aNan = std::isnan(a.key);
+    bool bNan = std::isnan(b.key);
+    if (aNan != bNan) return bNan;
+    if (!aNan && a.key != b.key) return a.key < b.key;
+    return a.index < b.index;
+}
+
+// Убывание сводится к возрастанию по -key; NaN остаётся NaN и по keyedLess всегда оказывается в конце
+inline double orderedKey(double key, SortOrder order) {
+    if (std::isnan(key)) return key;
+    return order == SortOrder::Descending ? -key : key;
+}
+
+// Перестановка по циклам: после вызова slots[i] содержит прежний slots[order[i].index]
+template <typename Slot>
+void applyPermutation(Slot* slots, const std::vector<KeyedIndex>& order) {
+    std::vector<bool> placed(order.size(), false);
+    for (size_t start = 0; start < order.size(); ++start) {
+        if (placed[start] || order[start].index == start) continue;
+        Slot saved = std::move(slots[start]);
+        size_t position = start;
+        while (true) {
+            placed[position] = true;
+            size_t source = order[position].index;
+            if (source == start) {
+                slots[position] = std::move(saved);
+                break;
+            }
+            slots[position] = std::move(slots[source]);
+            position = source;
+        }
+    }
+}
+
+// Ключи count фигур по фрагментам chunkSize; keyAt(i) - ключ фигуры i
+template <typename KeyAt>
+std::vector<KeyedIndex> computeKeys(size_t count, size_t chunkSize, KeyAt keyAt, SortOrder order, ThreadPool& pool) {
+    std::vector<KeyedIndex> entries(count);
+    pool.parallelFor((count + chunkSize - 1) / chunkSize, [&](size_t chunk) {
+        size_t end = std::min(count, (chunk + 1) * chunkSize);
+        for (size_t i = chunk * chunkSize; i < end; ++i) {
+            entries[i] = {orderedKey(keyAt(i), order), i};
+        }
+    });
+    return entries;
+}
+
+// Порядок для topK по ключам, упорядоченным по убыванию: k лучших по убыванию ключа,
+// затем остальные в исходном порядке. Отбор кандидатов выполняется параллельно по блокам.
+inline std::vector<KeyedIndex> topKOrder(std::vector<KeyedIndex> entries, size_t k, ThreadPool& pool) {
+    size_t count = entries.size();
+
+    // Каждый блок отдаёт свои k лучших; блоки не меньше 4k, чтобы кандидатов было мало
+    size_t blockSize = std::max<size_t>(4 * k, 1 << 16);
+    size_t blocks = (count + blockSize - 1) / blockSize;
+    std::vector<size_t> taken(blocks);
+    pool.parallelFor(blocks, [&](size_t block) {
+        auto first = entries.begin() + static_cast<std::ptrdiff_t>(block * blockSize);
+        auto last = entries.begin() + static_cast<std::ptrdiff_t>(std::min(count, (block + 1) * blockSize));
+        size_t take = std::min<size_t>(k, static_cast<size_t>(last - first));
+        std::nth_element(first, first + static_cast<std::ptrdiff_t>(take - 1), last, keyedLess);
+        taken[block] = take;
+    });
+
+    std::vector<KeyedIndex> candidates;
+    for (size_t block = 0; block < blocks; ++block) {
+        auto first = entries.begin() + static_cast<std::ptrdiff_t>(block * blockSize);
+        candidates.insert(candidates.end(), first, first + static_cast<std::ptrdiff_t>(taken[block]));
+    }
+    std::partial_sort(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(k), candidates.end(), keyedLess);
+    candidates.resize(k);
+
+    std::vector<bool> selected(count, false);
+    for (const KeyedIndex& entry : candidates) selected[entry.index] = true;
+    std::vector<KeyedIndex> order = std::move(candidates);
+    order.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        if (!selected[i]) order.push_back({0.0, i});
+    }
+    return order;
+}
+
+} // namespace ordering_detail
+
+#endif
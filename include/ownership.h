@@ -0,0 +1,190 @@
+#ifndef OWNERSHIP_H
+#define OWNERSHIP_H
+
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <variant>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include "figure.h"
+#include "triangle.h"
+#include "square.h"
+#include "rectangle.h"
+#include "static_array.h"
+
+// Политики владения элементами FigureArray.
+//
+// Политика задаёт тип дескриптора Handle<T>, который хранится в массиве, и способ создания
+// фигуры make<T, Kind>(arena, args...). Дескриптор поддерживает *, ->, reset() и перемещение.
+//   SharedOwnership    - std::shared_ptr (по умолчанию): фигуры можно разделять между массивами;
+//                        перемещение дескриптора и удаление затрагивают блок управления с атомарным счётчиком
+//   UniqueOwnership    - std::unique_ptr: одно выделение на фигуру, перемещение - копирование указателя
+//   IntrusiveOwnership - IntrusivePtr: разделяемое владение с неатомарным счётчиком внутри фигуры,
+//                        без отдельного блока управления
+//   ValueOwnership     - FigureValue: фигура лежит прямо в массиве без выделений; ссылки на элементы
+//                        становятся недействительными при перевыделении и удалении
+
+// Указатель с неатомарным счётчиком ссылок внутри Figure (IntrusiveRefCount)
+template <typename F>
+class IntrusivePtr {
+private:
+    template <typename G>
+    friend class IntrusivePtr;
+
+    F* _pointer = nullptr;
+
+    void retain() {
+        if (_pointer) ++_pointer->_references._count;
+    }
+
+public:
+    IntrusivePtr() = default;
+
+    // Захват фигуры, созданной через new
+    explicit IntrusivePtr(F* pointer) : _pointer(pointer) { retain(); }
+
+    IntrusivePtr(const IntrusivePtr& other) : _pointer(other._pointer) { retain(); }
+    IntrusivePtr(IntrusivePtr&& other) noexcept : _pointer(std::exchange(other._pointer, nullptr)) {}
+
+    // Преобразование к указателю на базовый класс
+    template <typename G, typename = std::enable_if_t<std::is_convertible_v<G*, F*>>>
+    IntrusivePtr(IntrusivePtr<G>&& other) noexcept : _pointer(std::exchange(other._pointer, nullptr)) {}
+
+    IntrusivePtr& operator=(IntrusivePtr other) noexcept {
+        std::swap(_pointer, other._pointer);
+        return *this;
+    }
+
+    ~IntrusivePtr() { reset(); }
+
+    void reset() {
+        if (_pointer && --_pointer->_references._count == 0) {
+            delete _pointer;
+        }
+        _pointer = nullptr;
+    }
+
+    F* get() const { return _pointer; }
+    F& operator*() const { return *_pointer; }
+    F* operator->() const { return _pointer; }
+    explicit operator bool() const { return _pointer != nullptr; }
+
+    // Число владельцев фигуры
+    unsigned useCount() const { return _pointer ? _pointer->_references._count : 0; }
+};
+
+template <typename Kind, typename... Args>
+IntrusivePtr<Kind> makeIntrusive(Args&&... args) {
+    return IntrusivePtr<Kind>(new Kind(std::forward<Args>(args)...));
+}
+
+// Фигура по значению (FigureVariant) с пустым состоянием после reset() и перемещения в массиве
+template <Scalar T>
+class FigureValue {
+private:
+    std::optional<FigureVariant<T>> _value;
+
+public:
+    FigureValue() = default;
+
+    template <typename Kind, typename... Args>
+    explicit FigureValue(std::in_place_type_t<Kind> kind, Args&&... args)
+        : _value(std::in_place, kind, std::forward<Args>(args)...) {}
+
+    FigureValue(const Triangle<T>& figure) : _value(std::in_place, figure) {}
+    FigureValue(const Square<T>& figure) : _value(std::in_place, figure) {}
+    FigureValue(const Rectangle<T>& figure) : _value(std::in_place, figure) {}
+
+    // Копия фигуры любого вида
+    FigureValue(const Figure<T>& figure) {
+        switch (figure.kind()) {
+            case FigureKind::Triangle:
+                _value.emplace(static_cast<const Triangle<T>&>(figure));
+                break;
+            case FigureKind::Square:
+                _value.emplace(static_cast<const Square<T>&>(figure));
+                break;
+            case FigureKind::Rectangle:
+                _value.emplace(static_cast<const Rectangle<T>&>(figure));
+                break;
+        }
+    }
+
+    Figure<T>* get() {
+        if (!_value) return nullptr;
+        return std::visit([](auto& f) -> Figure<T>* { return &f; }, *_value);
+    }
+
+    const Figure<T>* get() const {
+        if (!_value) return nullptr;
+        return std::visit([](const auto& f) -> const Figure<T>* { return &f; }, *_value);
+    }
+
+    Figure<T>& operator*() { return *get(); }
+    const Figure<T>& operator*() const { return *get(); }
+    Figure<T>* operator->() { return get(); }
+    const Figure<T>* operator->() const { return get(); }
+    explicit operator bool() const { return _value.has_value(); }
+
+    void reset() { _value.reset(); }
+
+    // Вариант для std::visit без виртуальных вызовов
+    const FigureVariant<T>& variant() const {
+        if (!_value) throw std::logic_error("Empty figure value");
+        return *_value;
+    }
+};
+
+struct SharedOwnership {
+    template <Scalar T>
+    using Handle = std::shared_ptr<Figure<T>>;
+
+    // Фигура и блок управления размещаются одним выделением в арене массива (или в куче без арены)
+    static constexpr bool usesArena = true;
+
+    template <Scalar T, typename Kind, typename... Args>
+    static Handle<T> make(std::pmr::memory_resource* arena, Args&&... args) {
+        if (!arena) return std::make_shared<Kind>(std::forward<Args>(args)...);
+        return std::allocate_shared<Kind>(std::pmr::polymorphic_allocator<Kind>(arena), std::forward<Args>(args)...);
+    }
+};
+
+struct UniqueOwnership {
+    template <Scalar T>
+    using Handle = std::unique_ptr<Figure<T>>;
+
+    static constexpr bool usesArena = false;
+
+    template <Scalar T, typename Kind, typename... Args>
+    static Handle<T> make(std::pmr::memory_resource*, Args&&... args) {
+        return std::make_unique<Kind>(std::forward<Args>(args)...);
+    }
+};
+
+struct IntrusiveOwnership {
+    template <Scalar T>
+    using Handle = IntrusivePtr<Figure<T>>;
+
+    static constexpr bool usesArena = false;
+
+    template <Scalar T, typename Kind, typename... Args>
+    static Handle<T> make(std::pmr::memory_resource*, Args&&... args) {
+        return makeIntrusive<Kind>(std::forward<Args>(args)...);
+    }
+};
+
+struct ValueOwnership {
+    template <Scalar T>
+    using Handle = FigureValue<T>;
+
+    static constexpr bool usesArena = false;
+
+    template <Scalar T, typename Kind, typename... Args>
+    static Handle<T> make(std::pmr::memory_resource*, Args&&... args) {
+        return FigureValue<T>(std::in_place_type<Kind>, std::forward<Args>(args)...);
+    }
+};
+
+#endif
@@ -0,0 +1,194 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+// Пул потоков фиксированного размера для параллельной обработки фрагментов (chunk) массива.
+// Вызывающий поток тоже обрабатывает фрагменты, поэтому пул из одного потока
+// не создаёт дополнительных потоков.
+class ThreadPool {
+private:
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::mutex _submitMutex;  // Одновременно выполняется только одно задание
+    std::condition_variable _wake;
+    std::condition_variable _done;
+
+    // Текущее задание
+    const std::function<void(size_t)>* _task = nullptr;
+    size_t _chunks = 0;
+    std::atomic<size_t> _nextChunk{0};
+    size_t _activeWorkers = 0;
+    size_t _generation = 0;
+    bool _stopping = false;
+    std::exception_ptr _error;
+
+    void runChunks(const std::function<void(size_t)>& task, size_t chunks) {
+        for (size_t chunk = _nextChunk++; chunk < chunks; chunk = _nextChunk++) {
+            try {
+                task(chunk);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_error) _error = std::current_exception();
+            }
+        }
+    }
+
+    void workerLoop() {
+        size_t seenGeneration = 0;
+        for (;;) {
+            const std::function<void(size_t)>* task;
+            size_t chunks;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [&] { return _stopping || _generation != seenGeneration; });
+                if (_stopping) return;
+                seenGeneration = _generation;
+                // Задание могло завершиться до пробуждения потока
+                if (!_task) continue;
+                task = _task;
+                chunks = _chunks;
+                ++_activeWorkers;
+            }
+            runChunks(*task, chunks);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                --_activeWorkers;
+            }
+            _done.notify_all();
+        }
+    }
+
+public:
+    // threads = 0 - по числу аппаратных потоков
+    explicit ThreadPool(size_t threads = 0) {
+        if (threads == 0) threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        for (size_t i = 1; i < threads; ++i) {
+            _workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_all();
+        for (auto& worker : _workers) {
+            worker.join();
+        }
+    }
+
+    size_t threadCount() const { return _workers.size() + 1; }
+
+    // Выполняет task(chunk) для всех chunk из [0, chunks) и дожидается завершения.
+    // Первое исключение из task пробрасывается вызывающему.
+    // task не должен сам вызывать parallelFor того же пула.
+    void parallelFor(size_t chunks, const std::function<void(size_t)>& task) {
+        if (chunks == 0) return;
+        if (_workers.empty() || chunks == 1) {
+            for (size_t chunk = 0; chunk < chunks; ++chunk) task(chunk);
+            return;
+        }
+
+        std::lock_guard<std::mutex> submitLock(_submitMutex);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _task = &task;
+            _chunks = chunks;
+            _nextChunk = 0;
+            _error = nullptr;
+            ++_generation;
+        }
+        _wake.notify_all();
+
+        runChunks(task, chunks);
+
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [&] { return _activeWorkers == 0; });
+            _task = nullptr;
+            error = _error;
+        }
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+// Общий пул по умолчанию (по числу аппаратных потоков)
+inline ThreadPool& defaultThreadPool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// Параллельная сортировка: блоки (их число - степень двойки не больше числа потоков) сортируются
+// std::sort, затем сливаются попарно по раундам через буфер. Value должен иметь конструктор по умолчанию.
+template <typename Value, typename Compare>
+void parallelSort(std::vector<Value>& values, Compare less, ThreadPool& pool = defaultThreadPool()) {
+    constexpr size_t minBlock = size_t(1) << 14;
+    size_t count = values.size();
+    size_t blocks = 1;
+    while (blocks * 2 <= pool.threadCount() && count / (blocks * 2) >= minBlock) blocks *= 2;
+    if (blocks == 1) {
+        std::sort(values.begin(), values.end(), less);
+        return;
+    }
+
+    auto bound = [&](size_t block) { return values.begin() + static_cast<std::ptrdiff_t>(count * block / blocks); };
+    pool.parallelFor(blocks, [&](size_t block) {
+        std::sort(bound(block), bound(block + 1), less);
+    });
+
+    std::vector<Value> buffer(count);
+    for (size_t width = 1; width < blocks; width *= 2) {
+        pool.parallelFor(blocks / (2 * width), [&](size_t pair) {
+            auto first = bound(2 * pair * width);
+            auto middle = bound((2 * pair + 1) * width);
+            auto last = bound((2 * pair + 2) * width);
+            std::merge(first, middle, middle, last, buffer.begin() + (first - values.begin()), less);
+        });
+        values.swap(buffer);
+    }
+}
+
+// Суммирование с компенсацией (Кэхэн-Бабушка)
+class KahanSum {
+private:
+    double _sum = 0.0;
+    double _compensation = 0.0;
+
+public:
+    void add(double value) {
+        double t = _sum + value;
+        if (std::abs(_sum) >= std::abs(value)) {
+            _compensation += (_sum - t) + value;
+        } else {
+            _compensation += (value - t) + _sum;
+        }
+        _sum = t;
+    }
+
+    double result() const { return _sum + _compensation; }
+};
+
+// Попарное суммирование частичных сумм в фиксированном порядке
+inline double pairwiseSum(const double* values, size_t count) {
+    if (count == 0) return 0.0;
+    if (count == 1) return values[0];
+    size_t half = count / 2;
+    return pairwiseSum(values, half) + pairwiseSum(values + half, count - half);
+}
+
+#endif
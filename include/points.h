@@ -6,8 +6,8 @@
 #include <concepts>
   
 // Константа для сравнения чисел с плавающей точкой
-const double EPS = 1e-6;
-inline const double PI = 3.14159265358979323846; 
+inline constexpr double EPS = 1e-6;
+inline constexpr double PI = 3.14159265358979323846;
  
 // Концепт для проверки, что тип T является скалярным
 template <typename T>
@@ -21,19 +21,19 @@ protected:
     T _y;  
     
 public:
-    Point();
-    Point(T x, T y);
-    Point(const Point& other);
-    Point(Point&& other) noexcept;
+    constexpr Point();
+    constexpr Point(T x, T y);
+    constexpr Point(const Point& other);
+    constexpr Point(Point&& other) noexcept;
 
-    T getX() const;
-    T getY() const;
+    constexpr T getX() const;
+    constexpr T getY() const;
 
-    Point& operator=(const Point& other);
-    Point& operator=(Point&& other) noexcept;
+    constexpr Point& operator=(const Point& other);
+    constexpr Point& operator=(Point&& other) noexcept;
 
-    bool operator==(const Point& other) const;
-    bool operator<(const Point& other) const;
+    constexpr bool operator==(const Point& other) const;
+    constexpr bool operator<(const Point& other) const;
 
     std::ostream& print(std::ostream& os) const;
 
@@ -45,35 +45,35 @@ public:
 
 // Конструктор по умолчанию
 template <Scalar T>
-Point<T>::Point() : _x(0), _y(0) {}
+constexpr Point<T>::Point() : _x(0), _y(0) {}
 
 // Конструктор с параметрами
 template <Scalar T>
-Point<T>::Point(T x, T y) : _x(x), _y(y) {}
+constexpr Point<T>::Point(T x, T y) : _x(x), _y(y) {}
 
 // Конструктор копирования
 template <Scalar T>
-Point<T>::Point(const Point& other) : _x(other._x), _y(other._y) {}
+constexpr Point<T>::Point(const Point& other) : _x(other._x), _y(other._y) {}
 
 // Конструктор перемещения
 template <Scalar T>
-Point<T>::Point(Point&& other) noexcept : _x(std::move(other._x)), _y(std::move(other._y)) {}
+constexpr Point<T>::Point(Point&& other) noexcept : _x(std::move(other._x)), _y(std::move(other._y)) {}
 
 // Метод для получения значения координаты X
 template <Scalar T>
-T Point<T>::getX() const {
+constexpr T Point<T>::getX() const {
     return _x;
 }
 
 // Метод для получения значения координаты Y
 template <Scalar T>
-T Point<T>::getY() const {
+constexpr T Point<T>::getY() const {
     return _y;
 }
 
 // Оператор присваивания копированием
 template <Scalar T>
-Point<T>& Point<T>::operator=(const Point& other) {
+constexpr Point<T>& Point<T>::operator=(const Point& other) {
     if (this != &other) {
         _x = other._x;
         _y = other._y;
@@ -83,7 +83,7 @@ Point<T>& Point<T>::operator=(const Point& other) {
 
 // Оператор присваивания перемещением
 template <Scalar T>
-Point<T>& Point<T>::operator=(Point&& other) noexcept {
+constexpr Point<T>& Point<T>::operator=(Point&& other) noexcept {
     if (this != &other) {
         _x = std::move(other._x);
         _y = std::move(other._y);
@@ -93,13 +93,16 @@ Point<T>& Point<T>::operator=(Point&& other) noexcept {
 
 // Оператор сравнения - равенство
 template <Scalar T>
-bool Point<T>::operator==(const Point& other) const {
-    return std::abs(_x - other._x) < EPS && std::abs(_y - other._y) < EPS;
+constexpr bool Point<T>::operator==(const Point& other) const {
+    // Модуль без std::abs, который не constexpr в C++20
+    T dx = _x - other._x;
+    T dy = _y - other._y;
+    return (dx < 0 ? -dx : dx) < EPS && (dy < 0 ? -dy : dy) < EPS;
 }
 
 // Оператор сравнения - "меньше"
 template <Scalar T>
-bool Point<T>::operator<(const Point& other) const {
+constexpr bool Point<T>::operator<(const Point& other) const {
     return _x < other._x || (_x == other._x && _y < other._y);
 }
 
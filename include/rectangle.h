@@ -2,17 +2,19 @@
 #define RECTANGLE_H
 
 #include "figure.h"
-#include <memory>
+#include "geometry.h"
+#include <array>
 #include <cmath>
 
 template <Scalar T>
 class Rectangle : public Figure<T> {
 private:
-    std::unique_ptr<Point<T>> p1, p2, p3, p4;
+    std::array<Point<T>, 4> _points;
 
 public:
     Rectangle();
     Rectangle(Point<T> a, Point<T> b, Point<T> c, Point<T> d);
+    explicit Rectangle(const RectangleShape<T>& shape);
     Rectangle(const Rectangle& other);
     Rectangle(Rectangle&& other) noexcept;
     Rectangle& operator=(const Rectangle& other);
@@ -26,6 +28,9 @@ public:
     virtual bool operator==(const Figure<T>& otherFig) const override;
     virtual bool operator!=(const Figure<T>& otherFig) const override;
     virtual bool checkValidity() const override;
+    virtual FigureKind kind() const override;
+    virtual size_t vertexCount() const override;
+    virtual Point<T> getVertex(size_t index) const override;
   
     ~Rectangle() = default;
 };
@@ -33,43 +38,39 @@ public:
 // Конструктор по умолчанию
 template <Scalar T>
 Rectangle<T>::Rectangle() 
-    : p1(std::make_unique<Point<T>>(T(0), T(0))),
-      p2(std::make_unique<Point<T>>(T(2), T(0))),
-      p3(std::make_unique<Point<T>>(T(2), T(1))),
-      p4(std::make_unique<Point<T>>(T(0), T(1))) {}
+    : _points{
+          Point<T>(T(0), T(0)),
+          Point<T>(T(2), T(0)),
+          Point<T>(T(2), T(1)),
+          Point<T>(T(0), T(1))
+      } {}
 
 // Конструктор с параметрами
 template <Scalar T>
 Rectangle<T>::Rectangle(Point<T> a, Point<T> b, Point<T> c, Point<T> d)
-    : p1(std::make_unique<Point<T>>(a)),
-      p2(std::make_unique<Point<T>>(b)),
-      p3(std::make_unique<Point<T>>(c)),
-      p4(std::make_unique<Point<T>>(d)) {}
+    : _points{a, b, c, d} {}
+
+// Конструктор из значимого типа
+template <Scalar T>
+Rectangle<T>::Rectangle(const RectangleShape<T>& shape)
+    : _points(shape.points) {}
 
 // Конструктор копирования
 template <Scalar T>
 Rectangle<T>::Rectangle(const Rectangle& other)
-    : p1(std::make_unique<Point<T>>(*other.p1)),
-      p2(std::make_unique<Point<T>>(*other.p2)),
-      p3(std::make_unique<Point<T>>(*other.p3)),
-      p4(std::make_unique<Point<T>>(*other.p4)) {}
+    : Figure<T>(other), _points(other._points) {}
 
 // Конструктор перемещения
 template <Scalar T>
 Rectangle<T>::Rectangle(Rectangle&& other) noexcept
-    : p1(std::move(other.p1)),
-      p2(std::move(other.p2)),
-      p3(std::move(other.p3)),
-      p4(std::move(other.p4)) {}
+    : Figure<T>(std::move(other)), _points(std::move(other._points)) {}
 
 // Оператор присваивания копированием
 template <Scalar T>
 Rectangle<T>& Rectangle<T>::operator=(const Rectangle& other) {
     if (this != &other) {
-        p1 = std::make_unique<Point<T>>(*other.p1);
-        p2 = std::make_unique<Point<T>>(*other.p2);
-        p3 = std::make_unique<Point<T>>(*other.p3);
-        p4 = std::make_unique<Point<T>>(*other.p4);
+        Figure<T>::operator=(other);
+        _points = other._points;
     }
     return *this;
 }
@@ -78,10 +79,8 @@ Rectangle<T>& Rectangle<T>::operator=(const Rectangle& other) {
 template <Scalar T>
 Rectangle<T>& Rectangle<T>::operator=(Rectangle&& other) noexcept {
     if (this != &other) {
-        p1 = std::move(other.p1);
-        p2 = std::move(other.p2);
-        p3 = std::move(other.p3);
-        p4 = std::move(other.p4);
+        Figure<T>::operator=(std::move(other));
+        _points = std::move(other._points);
     }
     return *this;
 }
@@ -89,7 +88,7 @@ Rectangle<T>& Rectangle<T>::operator=(Rectangle&& other) noexcept {
 // Вывод в поток
 template <Scalar T>
 void Rectangle<T>::output(std::ostream& os) const {
-    os << "Rectangle: " << *p1 << ", " << *p2 << ", " << *p3 << ", " << *p4;
+    os << "Rectangle: " << _points[0] << ", " << _points[1] << ", " << _points[2] << ", " << _points[3];
 }
 
 // Ввод из потока
@@ -101,10 +100,8 @@ void Rectangle<T>::input(std::istream& is) {
     }
     is >> a >> b >> c >> d;
     
-    p1 = std::make_unique<Point<T>>(a);
-    p2 = std::make_unique<Point<T>>(b);
-    p3 = std::make_unique<Point<T>>(c);
-    p4 = std::make_unique<Point<T>>(d);
+    _points = {a, b, c, d};
+    this->invalidateCache();
     
     if (!checkValidity()) {
         throw std::invalid_argument("Invalid rectangle vertices provided!");
@@ -114,50 +111,36 @@ void Rectangle<T>::input(std::istream& is) {
 // Центроид
 template <Scalar T>
 Point<T> Rectangle<T>::getCentroid() const {
-    T x = (p1->getX() + p2->getX() + p3->getX() + p4->getX()) / 4;
-    T y = (p1->getY() + p2->getY() + p3->getY() + p4->getY()) / 4;
-    return Point<T>(x, y);
+    return vertexCentroid(_points);
 }
 
 // Площадь
 template <Scalar T>
 double Rectangle<T>::calculateArea() const {
-    // Вычисляем длины смежных сторон
-    double side1 = std::sqrt(
-        std::pow(p2->getX() - p1->getX(), 2) + 
-        std::pow(p2->getY() - p1->getY(), 2)
-    );
-    double side2 = std::sqrt(
-        std::pow(p4->getX() - p1->getX(), 2) + 
-        std::pow(p4->getY() - p1->getY(), 2)
-    );
-    return side1 * side2;
+    return rectangleArea(_points);
 }
 
 // Оператор приведения к double
 template <Scalar T>
 Rectangle<T>::operator double() const {
-    return calculateArea();
+    return this->area();
 }
 
 // Оператор сравнения
 template <Scalar T>
 bool Rectangle<T>::operator==(const Figure<T>& otherFig) const {
-    const Rectangle* otherRect = dynamic_cast<const Rectangle*>(&otherFig);
-    if (!otherRect) return false;
+    // Вид проверяется без dynamic_cast
+    if (otherFig.kind() != FigureKind::Rectangle) return false;
+    const Rectangle* otherRect = static_cast<const Rectangle*>(&otherFig);
     
     // Проверяем все возможные циклические сдвиги вершин
-    const Point<T>* thisPoints[] = {p1.get(), p2.get(), p3.get(), p4.get()};
-    const Point<T>* otherPoints[] = {
-        otherRect->p1.get(), otherRect->p2.get(), 
-        otherRect->p3.get(), otherRect->p4.get()
-    };
+    const std::array<Point<T>, 4>& otherPoints = otherRect->_points;
     
     for (int offset = 0; offset < 4; ++offset) {
         bool isMatch = true;
         for (int i = 0; i < 4; ++i) {
             int shiftedIndex = (i + offset) % 4;
-            if (!(*thisPoints[i] == *otherPoints[shiftedIndex])) {
+            if (!(_points[i] == otherPoints[shiftedIndex])) {
                 isMatch = false;
                 break;
             }
@@ -176,33 +159,26 @@ bool Rectangle<T>::operator!=(const Figure<T>& otherFig) const {
 // Проверка валидности
 template <Scalar T>
 bool Rectangle<T>::checkValidity() const {
-    // Проверка на уникальность точек
-    const Point<T>* points[] = {p1.get(), p2.get(), p3.get(), p4.get()};
-    for (int i = 0; i < 4; ++i) {
-        for (int j = i + 1; j < 4; ++j) {
-            if (*points[i] == *points[j]) {
-                return false;
-            }
-        }
-    }
-    
-    // Вычисляем длины всех сторон
-    double sides[4];
-    sides[0] = std::sqrt(std::pow(p2->getX() - p1->getX(), 2) + std::pow(p2->getY() - p1->getY(), 2));
-    sides[1] = std::sqrt(std::pow(p3->getX() - p2->getX(), 2) + std::pow(p3->getY() - p2->getY(), 2));
-    sides[2] = std::sqrt(std::pow(p4->getX() - p3->getX(), 2) + std::pow(p4->getY() - p3->getY(), 2));
-    sides[3] = std::sqrt(std::pow(p1->getX() - p4->getX(), 2) + std::pow(p1->getY() - p4->getY(), 2));
-    
-    // Проверяем противоположные стороны на равенство
-    if (std::abs(sides[0] - sides[2]) > EPS || std::abs(sides[1] - sides[3]) > EPS) {
-        return false;
-    }
-    
-    // Проверка прямых углов через скалярное произведение
-    double dot1 = (p2->getX() - p1->getX()) * (p4->getX() - p1->getX()) + 
-                  (p2->getY() - p1->getY()) * (p4->getY() - p1->getY());
-    
-    return std::abs(dot1) < EPS; // Скалярное произведение должно быть близко к 0 для прямого угла
+    return rectangleValid(_points);
+}
+
+// Вид фигуры
+template <Scalar T>
+FigureKind Rectangle<T>::kind() const {
+    return FigureKind::Rectangle;
+}
+
+// Количество вершин
+template <Scalar T>
+size_t Rectangle<T>::vertexCount() const {
+    return 4;
+}
+
+// Доступ к вершине по индексу
+template <Scalar T>
+Point<T> Rectangle<T>::getVertex(size_t index) const {
+    if (index >= 4) throw std::out_of_range("Vertex index out of bounds");
+    return _points[index];
 }
 
 #endif
\ No newline at end of file
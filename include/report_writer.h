@@ -0,0 +1,420 @@
+#ifndef REPORT_WRITER_H
+#define REPORT_WRITER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include "figure.h"
+#include "parallel.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Приёмник отчёта - получает уже отформатированные блоки байтов
+class ReportSink {
+public:
+    virtual void write(const char* data, size_t size) = 0;
+    virtual void flush() {}
+    virtual ~ReportSink() = default;
+};
+
+// Дописывание в строку
+class StringSink : public ReportSink {
+private:
+    std::string& _target;
+
+public:
+    explicit StringSink(std::string& target) : _target(target) {}
+
+    void write(const char* data, size_t size) override {
+        _target.append(data, size);
+    }
+};
+
+// Вывод в поток (например, std::cout)
+class OstreamSink : public ReportSink {
+private:
+    std::ostream& _os;
+
+public:
+    explicit OstreamSink(std::ostream& os) : _os(os) {}
+
+    void write(const char* data, size_t size) override {
+        _os.write(data, static_cast<std::streamsize>(size));
+        if (!_os) throw std::runtime_error("Failed to write report");
+    }
+
+    void flush() override {
+        _os.flush();
+    }
+};
+
+// Запись в файловый дескриптор (один системный вызов на блок буфера)
+class FdSink : public ReportSink {
+private:
+    int _fd;
+
+public:
+    explicit FdSink(int fd) : _fd(fd) {}
+
+    void write(const char* data, size_t size) override {
+        while (size > 0) {
+#ifdef _WIN32
+            int written = ::_write(_fd, data, static_cast<unsigned>(std::min<size_t>(size, 1u << 30)));
+#else
+            ssize_t written = ::write(_fd, data, size);
+#endif
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("Failed to write report");
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+    }
+};
+
+#ifndef _WIN32
+// Запись в файл через отображение в память: файл растёт шагами (удвоением)
+// и в конце обрезается до фактического размера
+class MappedFileSink : public ReportSink {
+private:
+    int _fd = -1;
+    char* _data = nullptr;
+    size_t _capacity = 0;
+    size_t _size = 0;
+
+    void remap(size_t capacity) {
+        if (_data) ::munmap(_data, _capacity);
+        _data = nullptr;
+        if (::ftruncate(_fd, static_cast<off_t>(capacity)) != 0) {
+            throw std::runtime_error("Cannot resize report file");
+        }
+        void* data = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+        if (data == MAP_FAILED) throw std::runtime_error("Cannot map report file");
+        _data = static_cast<char*>(data);
+        _capacity = capacity;
+    }
+
+public:
+    explicit MappedFileSink(const std::string& path, size_t initialCapacity = 16 << 20) {
+        _fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (_fd < 0) throw std::runtime_error("Cannot open report file: " + path);
+        try {
+            remap(std::max<size_t>(initialCapacity, 4096));
+        } catch (...) {
+            ::close(_fd);
+            throw;
+        }
+    }
+
+    MappedFileSink(const MappedFileSink& other) = delete;
+    MappedFileSink& operator=(const MappedFileSink& other) = delete;
+
+    void write(const char* data, size_t size) override {
+        if (_size + size > _capacity) {
+            remap(std::max(_capacity * 2, _size + size));
+        }
+        std::memcpy(_data + _size, data, size);
+        _size += size;
+    }
+
+    // Отображение снимается, файл обрезается до записанного размера
+    void close() {
+        if (_fd < 0) return;
+        if (_data) ::munmap(_data, _capacity);
+        _data = nullptr;
+        int result = ::ftruncate(_fd, static_cast<off_t>(_size));
+        ::close(_fd);
+        _fd = -1;
+        if (result != 0) throw std::runtime_error("Cannot resize report file");
+    }
+
+    size_t size() const { return _size; }
+
+    ~MappedFileSink() override {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+};
+#endif
+
+// Формат отчёта
+enum class ReportFormat {
+    Human,     // "0: Square: (0.00, 0.00), ... | Area = 4.00", как displayAreas/displayCentroids
+    Csv,       // Заголовок и строки "index,kind,area" / "index,x,y"
+    JsonLines  // Один JSON-объект на строку
+};
+
+// Класс ReportWriter - форматирование отчётов через std::to_chars в большой переиспользуемый буфер.
+// Приёмник получает данные блоками размера буфера, поэтому вывод не делает системный вызов на строку.
+// В формате Human вещественные числа выводятся с фиксированной точностью, в CSV и JSON -
+// в кратчайшей форме, восстанавливающей значение точно.
+class ReportWriter {
+private:
+    static constexpr size_t maxNumberLength = 512;  // Вещественное число в фиксированной форме
+    static constexpr size_t parallelChunkSize = 4096;
+
+    ReportSink& _sink;
+    ReportFormat _format;
+    int _precision;
+    std::vector<char> _buffer;
+    size_t _used = 0;
+
+    // Гарантирует свободное место под size байт
+    char* room(size_t size) {
+        if (_used + size > _buffer.size()) {
+            flushBuffer();
+            if (size > _buffer.size()) _buffer.resize(size);
+        }
+        return _buffer.data() + _used;
+    }
+
+    void flushBuffer() {
+        if (_used > 0) {
+            _sink.write(_buffer.data(), _used);
+            _used = 0;
+        }
+    }
+
+    void append(const char* text, size_t size) {
+        std::memcpy(room(size), text, size);
+        _used += size;
+    }
+
+    template <size_t N>
+    void append(const char (&text)[N]) {
+        append(text, N - 1);
+    }
+
+    template <typename V>
+    void appendNumber(V value) {
+        char* out = room(maxNumberLength);
+        std::to_chars_result result;
+        if constexpr (std::is_floating_point_v<V>) {
+            if (_format == ReportFormat::JsonLines && !std::isfinite(value)) {
+                append("null");
+                return;
+            }
+            result.ec = std::errc::value_too_large;
+            if (_format == ReportFormat::Human) {
+                result = std::to_chars(out, out + maxNumberLength, value, std::chars_format::fixed, _precision);
+            }
+            // Кратчайшая форма - и при слишком длинной фиксированной записи
+            if (result.ec != std::errc()) {
+                result = std::to_chars(out, out + maxNumberLength, value);
+            }
+        } else {
+            result = std::to_chars(out, out + maxNumberLength, value);
+        }
+        _used += static_cast<size_t>(result.ptr - out);
+    }
+
+    template <Scalar T>
+    void appendPoint(const Point<T>& point) {
+        append("(");
+        appendNumber(point.getX());
+        append(", ");
+        appendNumber(point.getY());
+        append(")");
+    }
+
+    static const char* kindName(FigureKind kind, bool capitalized) {
+        switch (kind) {
+            case FigureKind::Triangle: return capitalized ? "Triangle" : "triangle";
+            case FigureKind::Square: return capitalized ? "Square" : "square";
+            case FigureKind::Rectangle: return capitalized ? "Rectangle" : "rectangle";
+        }
+        return "";
+    }
+
+    void appendKind(FigureKind kind, bool capitalized) {
+        const char* name = kindName(kind, capitalized);
+        append(name, std::strlen(name));
+    }
+
+    void appendRowStart(size_t index) {
+        if (_format == ReportFormat::JsonLines) {
+            append("{\"index\":");
+            appendNumber(index);
+        } else {
+            appendNumber(index);
+            if (_format == ReportFormat::Human) {
+                append(": ");
+            } else {
+                append(",");
+            }
+        }
+    }
+
+    template <typename Row>
+    void writeChunksParallel(size_t count, ThreadPool& pool, Row row) {
+        size_t chunks = (count + parallelChunkSize - 1) / parallelChunkSize;
+        std::vector<std::string> texts(chunks);
+        pool.parallelFor(chunks, [&](size_t chunk) {
+            StringSink sink(texts[chunk]);
+            ReportWriter writer(sink, _format, _precision, 64 << 10);
+            size_t end = std::min(count, (chunk + 1) * parallelChunkSize);
+            for (size_t i = chunk * parallelChunkSize; i < end; ++i) {
+                row(writer, i);
+            }
+            writer.flush();
+        });
+        for (const std::string& text : texts) {
+            writeRaw(text.data(), text.size());
+        }
+    }
+
+public:
+    explicit ReportWriter(ReportSink& sink, ReportFormat format = ReportFormat::Human,
+                          int precision = 2, size_t bufferSize = 1 << 20)
+        : _sink(sink), _format(format), _precision(precision),
+          _buffer(std::max(bufferSize, 2 * maxNumberLength)) {}
+
+    ReportWriter(const ReportWriter& other) = delete;
+    ReportWriter& operator=(const ReportWriter& other) = delete;
+
+    ~ReportWriter() {
+        try {
+            flushBuffer();
+        } catch (...) {
+        }
+    }
+
+    ReportFormat format() const { return _format; }
+
+    // Передача буфера приёмнику и сброс приёмника
+    void flush() {
+        flushBuffer();
+        _sink.flush();
+    }
+
+    // Дописывание готового текста (например, отформатированного другим ReportWriter)
+    void writeRaw(const char* text, size_t size) {
+        if (size >= _buffer.size()) {
+            flushBuffer();
+            _sink.write(text, size);
+        } else {
+            append(text, size);
+        }
+    }
+
+    // Заголовки CSV (в остальных форматах ничего не пишут)
+    void writeAreaHeader() {
+        if (_format == ReportFormat::Csv) append("index,kind,area\n");
+    }
+
+    void writeCentroidHeader() {
+        if (_format == ReportFormat::Csv) append("index,x,y\n");
+    }
+
+    // Строка отчёта о площади фигуры
+    template <Scalar T>
+    void writeAreaRow(size_t index, const Figure<T>& figure, double area) {
+        appendRowStart(index);
+        switch (_format) {
+            case ReportFormat::Human:
+                appendKind(figure.kind(), true);
+                append(": ");
+                for (size_t v = 0; v < figure.vertexCount(); ++v) {
+                    if (v > 0) append(", ");
+                    appendPoint(figure.getVertex(v));
+                }
+                append(" | Area = ");
+                appendNumber(area);
+                append("\n");
+                break;
+            case ReportFormat::Csv:
+                appendKind(figure.kind(), false);
+                append(",");
+                appendNumber(area);
+                append("\n");
+                break;
+            case ReportFormat::JsonLines:
+                append(",\"kind\":\"");
+                appendKind(figure.kind(), false);
+                append("\",\"area\":");
+                appendNumber(area);
+                append("}\n");
+                break;
+        }
+    }
+
+    // Строка отчёта о центроиде фигуры
+    template <Scalar T>
+    void writeCentroidRow(size_t index, const Point<T>& centroid) {
+        appendRowStart(index);
+        switch (_format) {
+            case ReportFormat::Human:
+                append("Centroid = ");
+                appendPoint(centroid);
+                append("\n");
+                break;
+            case ReportFormat::Csv:
+                appendNumber(centroid.getX());
+                append(",");
+                appendNumber(centroid.getY());
+                append("\n");
+                break;
+            case ReportFormat::JsonLines:
+                append(",\"x\":");
+                appendNumber(centroid.getX());
+                append(",\"y\":");
+                appendNumber(centroid.getY());
+                append("}\n");
+                break;
+        }
+    }
+
+    // Отчёты по контейнеру с operator[] (FigureArray, StaticFigureArray)
+    template <typename Container>
+    void writeAreas(const Container& figures) {
+        writeAreaHeader();
+        for (size_t i = 0; i < figures.size(); ++i) {
+            writeAreaRow(i, figures[i], figures[i].area());
+        }
+    }
+
+    template <typename Container>
+    void writeCentroids(const Container& figures) {
+        writeCentroidHeader();
+        for (size_t i = 0; i < figures.size(); ++i) {
+            writeCentroidRow(i, figures[i].centroid());
+        }
+    }
+
+    // Параллельное форматирование: фрагменты форматируются в отдельные буферы,
+    // в приёмник попадают последовательно в исходном порядке
+    template <typename Container>
+    void writeAreasParallel(const Container& figures, ThreadPool& pool = defaultThreadPool()) {
+        writeAreaHeader();
+        writeChunksParallel(figures.size(), pool, [&](ReportWriter& writer, size_t i) {
+            writer.writeAreaRow(i, figures[i], figures[i].area());
+        });
+    }
+
+    template <typename Container>
+    void writeCentroidsParallel(const Container& figures, ThreadPool& pool = defaultThreadPool()) {
+        writeCentroidHeader();
+        writeChunksParallel(figures.size(), pool, [&](ReportWriter& writer, size_t i) {
+            writer.writeCentroidRow(i, figures[i].centroid());
+        });
+    }
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <algorithm>
+
+// Векторные пути доступны только для GCC/Clang на x86 (нужны атрибуты target и __builtin_cpu_supports).
+// На остальных платформах и компиляторах используется скалярный путь.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define FIGURES_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define FIGURES_SIMD_X86 0
+#endif
+
+// Уровень набора векторных инструкций (по возрастанию ширины)
+enum class SimdLevel {
+    Scalar,
+    SSE2,
+    AVX2,
+    AVX512
+};
+
+// Определение лучшего доступного уровня во время выполнения (результат кэшируется)
+inline SimdLevel detectSimdLevel() {
+#if FIGURES_SIMD_X86
+    static const SimdLevel level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+        if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+        if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+        return SimdLevel::Scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+// Запрошенный уровень, ограниченный возможностями процессора
+inline SimdLevel clampSimdLevel(SimdLevel requested) {
+    return std::min(requested, detectSimdLevel());
+}
+
+inline const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::SSE2: return "sse2";
+        case SimdLevel::AVX2: return "avx2";
+        case SimdLevel::AVX512: return "avx512";
+    }
+    return "unknown";
+}
+
+#endif
@@ -0,0 +1,429 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include <vector>
+#include <queue>
+#include <optional>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <bit>
+#include "figure.h"
+#include "array.h"
+
+// Проверка принадлежности точки выпуклой фигуре (граница включается)
+template <Scalar T>
+bool figureContains(const Figure<T>& figure, const Point<T>& point) {
+    size_t n = figure.vertexCount();
+    double px = static_cast<double>(point.getX());
+    double py = static_cast<double>(point.getY());
+    bool hasPositive = false;
+    bool hasNegative = false;
+    for (size_t i = 0; i < n; ++i) {
+        Point<T> a = figure.getVertex(i);
+        Point<T> b = figure.getVertex((i + 1) % n);
+        double ax = static_cast<double>(a.getX());
+        double ay = static_cast<double>(a.getY());
+        double cross = (static_cast<double>(b.getX()) - ax) * (py - ay) -
+                       (static_cast<double>(b.getY()) - ay) * (px - ax);
+        if (cross > EPS) hasPositive = true;
+        if (cross < -EPS) hasNegative = true;
+        if (hasPositive && hasNegative) return false;
+    }
+    return true;
+}
+
+// Шаблонный класс SpatialIndex - R-деревья над ограничивающими прямоугольниками фигур FigureArray.
+//
+// Деревья строятся пакетно методом STR (Sort-Tile-Recursive) и не меняются после построения.
+// Вставки накапливаются в буфере не больше pendingLimit записей; заполненный буфер сливается
+// в уровни (логарифмический метод): уровень i - дерево не больше pendingLimit * 2^i записей,
+// занятые уровни поглощаются при переносе, как разряды двоичного счётчика. Вставка стоит
+// амортизированно O(log^2 n), запросы обходят буфер и O(log n) деревьев - O(log^2 n + k).
+// Удалённые записи помечаются; когда их становится больше половины, индекс перестраивается.
+//
+// Записи ссылаются на фигуры через номера ячеек: номера возрастают вместе с индексами фигур,
+// удаление освобождает ячейку в счётчике Фенвика, и индекс фигуры - число живых ячеек до её номера.
+// Поэтому erase и eraseUnordered стоят O(log n), а не сдвигают все записи.
+//
+// Индекс не владеет массивом: после каждого add/erase массива нужно вызвать
+// соответствующий метод onAdd/onErase/onEraseUnordered индекса.
+// Ownership - политика владения индексируемого FigureArray (ownership.h).
+template <typename T, typename Ownership = SharedOwnership>
+class SpatialIndex {
+private:
+    static constexpr size_t nodeCapacity = 16;
+    static constexpr size_t pendingLimit = 32;
+    static constexpr size_t noEntry = static_cast<size_t>(-1);
+
+    struct Entry {
+        BoundingBox<T> box;
+        Point<T> centroid;
+        size_t slot;
+        bool alive;
+    };
+
+    struct Node {
+        BoundingBox<T> box;
+        size_t first;  // Первый потомок: позиция в leafEntries (лист) или индекс узла
+        size_t count;
+        bool leaf;
+    };
+
+    // Статическое STR-дерево над набором записей; корень - последний узел
+    struct Tree {
+        std::vector<Node> nodes;
+        std::vector<size_t> leafEntries;  // Позиции записей в порядке листьев
+
+        bool empty() const { return leafEntries.empty(); }
+    };
+
+    const FigureArray<T, Ownership>* _array;
+    std::vector<Entry> _entries;
+    std::vector<size_t> _slotEntry;  // Номер ячейки -> позиция записи (noEntry - ячейка освобождена)
+    std::vector<size_t> _fenwick;    // Число живых ячеек (дерево Фенвика, индексация с 1)
+    size_t _live = 0;
+    std::vector<size_t> _pending;    // Записи, ещё не попавшие в деревья
+    std::vector<Tree> _levels;
+    size_t _deadCount = 0;
+
+    static double centerX(const BoundingBox<T>& box) {
+        return (static_cast<double>(box.minX) + static_cast<double>(box.maxX)) / 2;
+    }
+
+    static double centerY(const BoundingBox<T>& box) {
+        return (static_cast<double>(box.minY) + static_cast<double>(box.maxY)) / 2;
+    }
+
+    // Квадрат расстояния от точки до прямоугольника
+    static double minDistance2(const BoundingBox<T>& box, double x, double y) {
+        double dx = std::max({static_cast<double>(box.minX) - x, 0.0, x - static_cast<double>(box.maxX)});
+        double dy = std::max({static_cast<double>(box.minY) - y, 0.0, y - static_cast<double>(box.maxY)});
+        return dx * dx + dy * dy;
+    }
+
+    static double distance2(const Point<T>& point, double x, double y) {
+        double dx = static_cast<double>(point.getX()) - x;
+        double dy = static_cast<double>(point.getY()) - y;
+        return dx * dx + dy * dy;
+    }
+
+    // Упорядочивание элементов по STR: полосы по x, внутри полосы - по y
+    template <typename BoxOf>
+    static void strSort(std::vector<size_t>& items, BoxOf boxOf) {
+        size_t leaves = (items.size() + nodeCapacity - 1) / nodeCapacity;
+        size_t slices = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(leaves))));
+        size_t sliceSize = std::max<size_t>(1, slices) * nodeCapacity;
+
+        std::sort(items.begin(), items.end(), [&](size_t a, size_t b) {
+            return centerX(boxOf(a)) < centerX(boxOf(b));
+        });
+        for (size_t start = 0; start < items.size(); start += sliceSize) {
+            auto end = items.begin() + static_cast<std::ptrdiff_t>(std::min(items.size(), start + sliceSize));
+            std::sort(items.begin() + static_cast<std::ptrdiff_t>(start), end, [&](size_t a, size_t b) {
+                return centerY(boxOf(a)) < centerY(boxOf(b));
+            });
+        }
+    }
+
+    Tree buildTree(std::vector<size_t> positions) const {
+        Tree tree;
+        tree.leafEntries = std::move(positions);
+        strSort(tree.leafEntries, [&](size_t e) -> const BoundingBox<T>& { return _entries[e].box; });
+        std::vector<Node>& nodes = tree.nodes;
+
+        // Листья
+        const std::vector<size_t>& leafEntries = tree.leafEntries;
+        for (size_t start = 0; start < leafEntries.size(); start += nodeCapacity) {
+            size_t count = std::min(nodeCapacity, leafEntries.size() - start);
+            BoundingBox<T> box = _entries[leafEntries[start]].box;
+            for (size_t i = 1; i < count; ++i) box.expand(_entries[leafEntries[start + i]].box);
+            nodes.push_back(Node{box, start, count, true});
+        }
+
+        // Внутренние уровни: узлы уровня упорядочиваются по STR и группируются по nodeCapacity
+        size_t levelStart = 0;
+        while (nodes.size() - levelStart > 1) {
+            size_t levelEnd = nodes.size();
+            std::vector<size_t> order(levelEnd - levelStart);
+            for (size_t i = 0; i < order.size(); ++i) order[i] = levelStart + i;
+            strSort(order, [&](size_t n) -> const BoundingBox<T>& { return nodes[n].box; });
+
+            std::vector<Node> level;
+            level.reserve(order.size());
+            for (size_t n : order) level.push_back(nodes[n]);
+            std::copy(level.begin(), level.end(), nodes.begin() + static_cast<std::ptrdiff_t>(levelStart));
+
+            for (size_t start = levelStart; start < levelEnd; start += nodeCapacity) {
+                size_t count = std::min(nodeCapacity, levelEnd - start);
+                BoundingBox<T> box = nodes[start].box;
+                for (size_t i = 1; i < count; ++i) box.expand(nodes[start + i].box);
+                nodes.push_back(Node{box, start, count, false});
+            }
+            levelStart = levelEnd;
+        }
+        return tree;
+    }
+
+    static size_t levelCapacity(size_t level) {
+        return pendingLimit << level;
+    }
+
+    // Перенос записей в уровни: занятые уровни поглощаются, пока записи не поместятся в свободный
+    void flush(std::vector<size_t> carry) {
+        for (size_t level = 0;; ++level) {
+            if (level == _levels.size()) _levels.emplace_back();
+            Tree& tree = _levels[level];
+            if (tree.empty()) {
+                if (carry.size() <= levelCapacity(level)) {
+                    if (!carry.empty()) tree = buildTree(std::move(carry));
+                    return;
+                }
+                continue;
+            }
+            for (size_t position : tree.leafEntries) {
+                if (_entries[position].alive) carry.push_back(position);
+            }
+            tree = Tree();
+        }
+    }
+
+    // Дерево Фенвика над живыми ячейками
+    size_t livePrefix(size_t slots) const {
+        size_t sum = 0;
+        for (size_t i = slots; i > 0; i &= i - 1) sum += _fenwick[i - 1];
+        return sum;
+    }
+
+    void pushSlot() {
+        size_t n = _fenwick.size() + 1;
+        size_t low = n & (~n + 1);
+        _fenwick.push_back(1 + livePrefix(n - 1) - livePrefix(n - low));
+    }
+
+    void releaseSlot(size_t slot) {
+        _slotEntry[slot] = noEntry;
+        for (size_t i = slot + 1; i <= _fenwick.size(); i += i & (~i + 1)) --_fenwick[i - 1];
+        // Освобождённые ячейки в конце отбрасываются: без пропусков номер ячейки равен индексу фигуры
+        while (!_slotEntry.empty() && _slotEntry.back() == noEntry) {
+            _slotEntry.pop_back();
+            _fenwick.pop_back();
+        }
+    }
+
+    size_t figureOf(size_t slot) const {
+        return _slotEntry.size() == _live ? slot : livePrefix(slot);
+    }
+
+    // Ячейка фигуры с индексом figure (спуск по дереву Фенвика)
+    size_t slotOf(size_t figure) const {
+        if (_slotEntry.size() == _live) return figure;
+        size_t position = 0;
+        size_t step = std::bit_floor(_fenwick.size());
+        for (; step > 0; step >>= 1) {
+            if (position + step <= _fenwick.size() && _fenwick[position + step - 1] <= figure) {
+                position += step;
+                figure -= _fenwick[position - 1];
+            }
+        }
+        return position;
+    }
+
+    size_t entryOf(size_t figure) const {
+        return _slotEntry[slotOf(figure)];
+    }
+
+    size_t addEntry(size_t figure, size_t slot) {
+        const Figure<T>& f = (*_array)[figure];
+        _entries.push_back(Entry{f.boundingBox(), f.centroid(), slot, true});
+        _slotEntry[slot] = _entries.size() - 1;
+        return _entries.size() - 1;
+    }
+
+    void killEntry(size_t position) {
+        _entries[position].alive = false;
+        ++_deadCount;
+    }
+
+    void addPending(size_t position) {
+        _pending.push_back(position);
+        if (_pending.size() >= pendingLimit) {
+            flush(std::move(_pending));
+            _pending.clear();
+        }
+    }
+
+    void maybeRebuild() {
+        if (_deadCount > std::max<size_t>(32, _live / 2)) {
+            rebuild();
+        }
+    }
+
+    // Обход записей, прямоугольники которых пересекают окно
+    template <typename Visit>
+    void visitWindow(const Tree& tree, const BoundingBox<T>& window, Visit& visit) const {
+        std::vector<size_t> stack{tree.nodes.size() - 1};
+        while (!stack.empty()) {
+            const Node& node = tree.nodes[stack.back()];
+            stack.pop_back();
+            if (!node.box.intersects(window)) continue;
+            for (size_t i = node.first; i < node.first + node.count; ++i) {
+                if (node.leaf) {
+                    visit(tree.leafEntries[i]);
+                } else {
+                    stack.push_back(i);
+                }
+            }
+        }
+    }
+
+public:
+    explicit SpatialIndex(const FigureArray<T, Ownership>& array) : _array(&array) {
+        rebuild();
+    }
+
+    // Полное перестроение по текущему содержимому массива
+    void rebuild() {
+        size_t count = _array->size();
+        _entries.clear();
+        _pending.clear();
+        _levels.clear();
+        _deadCount = 0;
+        _live = count;
+        _slotEntry.assign(count, noEntry);
+        _fenwick.resize(count);
+        for (size_t i = 1; i <= count; ++i) _fenwick[i - 1] = i & (~i + 1);
+        _entries.reserve(count);
+        std::vector<size_t> positions(count);
+        for (size_t i = 0; i < count; ++i) {
+            positions[i] = addEntry(i, i);
+        }
+        flush(std::move(positions));
+    }
+
+    size_t size() const { return _live; }
+
+    // Учёт фигуры, только что добавленной в конец массива
+    void onAdd() {
+        size_t figure = _array->size() - 1;
+        if (figure != _live) throw std::logic_error("Spatial index is out of sync with the array");
+        _slotEntry.push_back(noEntry);
+        pushSlot();
+        ++_live;
+        addPending(addEntry(figure, _slotEntry.size() - 1));
+    }
+
+    // Учёт FigureArray::erase(index): индексы последующих фигур уменьшаются на 1
+    void onErase(size_t index) {
+        if (index >= _live) throw std::out_of_range("Index invalid");
+        size_t slot = slotOf(index);
+        killEntry(_slotEntry[slot]);
+        --_live;
+        releaseSlot(slot);
+        maybeRebuild();
+    }
+
+    // Учёт FigureArray::eraseUnordered(index): последняя фигура получает индекс index
+    void onEraseUnordered(size_t index) {
+        if (index >= _live) throw std::out_of_range("Index invalid");
+        size_t slot = slotOf(index);
+        size_t lastSlot = slotOf(_live - 1);
+        killEntry(_slotEntry[slot]);
+        if (slot != lastSlot) {
+            // Последняя фигура занимает ячейку удалённой: порядок номеров сохраняется
+            _slotEntry[slot] = _slotEntry[lastSlot];
+            _entries[_slotEntry[slot]].slot = slot;
+        }
+        --_live;
+        releaseSlot(lastSlot);
+        maybeRebuild();
+    }
+
+    // Учёт изменения вершин фигуры
+    void onUpdate(size_t index) {
+        if (index >= _live) throw std::out_of_range("Index invalid");
+        size_t slot = slotOf(index);
+        killEntry(_slotEntry[slot]);
+        addPending(addEntry(index, slot));
+        maybeRebuild();
+    }
+
+    // Фигуры, ограничивающие прямоугольники которых пересекают окно (индексы по возрастанию)
+    std::vector<size_t> queryWindow(const BoundingBox<T>& window) const {
+        std::vector<size_t> result;
+        auto visit = [&](size_t position) {
+            const Entry& entry = _entries[position];
+            if (entry.alive && entry.box.intersects(window)) result.push_back(entry.slot);
+        };
+
+        for (const Tree& tree : _levels) {
+            if (!tree.empty()) visitWindow(tree, window, visit);
+        }
+        for (size_t position : _pending) visit(position);
+
+        std::sort(result.begin(), result.end());
+        for (size_t& slot : result) slot = figureOf(slot);
+        return result;
+    }
+
+    // Фигуры, содержащие точку (индексы по возрастанию)
+    std::vector<size_t> queryPoint(const Point<T>& point) const {
+        std::vector<size_t> result = queryWindow(BoundingBox<T>{point.getX(), point.getY(), point.getX(), point.getY()});
+        result.erase(std::remove_if(result.begin(), result.end(), [&](size_t figure) {
+            return !figureContains((*_array)[figure], point);
+        }), result.end());
+        return result;
+    }
+
+    // Фигура с ближайшим к точке центроидом (поиск по принципу "сначала лучший" по всем деревьям)
+    std::optional<size_t> nearestCentroid(const Point<T>& point) const {
+        double x = static_cast<double>(point.getX());
+        double y = static_cast<double>(point.getY());
+
+        double best = std::numeric_limits<double>::infinity();
+        std::optional<size_t> bestSlot;
+        auto consider = [&](size_t position) {
+            const Entry& entry = _entries[position];
+            if (!entry.alive) return;
+            double d = distance2(entry.centroid, x, y);
+            if (d < best || (d == best && bestSlot && entry.slot < *bestSlot)) {
+                best = d;
+                bestSlot = entry.slot;
+            }
+        };
+
+        for (size_t position : _pending) consider(position);
+
+        // Центроид лежит внутри ограничивающего прямоугольника, поэтому расстояние
+        // до прямоугольника узла - нижняя оценка расстояния до центроидов в нём.
+        // Элемент очереди: (расстояние, уровень, узел)
+        using Item = std::tuple<double, size_t, size_t>;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+        for (size_t level = 0; level < _levels.size(); ++level) {
+            const Tree& tree = _levels[level];
+            if (!tree.empty()) queue.push({minDistance2(tree.nodes.back().box, x, y), level, tree.nodes.size() - 1});
+        }
+        while (!queue.empty()) {
+            auto [distance, level, index] = queue.top();
+            queue.pop();
+            if (distance > best) break;
+
+            const Tree& tree = _levels[level];
+            const Node& node = tree.nodes[index];
+            for (size_t i = node.first; i < node.first + node.count; ++i) {
+                if (node.leaf) {
+                    consider(tree.leafEntries[i]);
+                } else {
+                    double d = minDistance2(tree.nodes[i].box, x, y);
+                    if (d <= best) queue.push({d, level, i});
+                }
+            }
+        }
+        if (!bestSlot) return std::nullopt;
+        return figureOf(*bestSlot);
+    }
+};
+
+#endif
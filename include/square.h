@@ -2,16 +2,18 @@
 #define SQUARE_H
 
 #include "figure.h"
-#include <memory>
+#include "geometry.h"
+#include <array>
  
 template <Scalar T>
 class Square : public Figure<T> {
 private:
-    std::unique_ptr<Point<T>> p1, p2, p3, p4;
+    std::array<Point<T>, 4> _points;
    
 public:
     Square();
     Square(Point<T> a, Point<T> b, Point<T> c, Point<T> d);
+    explicit Square(const SquareShape<T>& shape);
     Square(const Square& other);
     Square(Square&& other) noexcept;
     Square& operator=(const Square& other);
@@ -25,6 +27,9 @@ public:
     virtual bool operator==(const Figure<T>& otherFig) const override;
     virtual bool operator!=(const Figure<T>& otherFig) const override;
     virtual bool checkValidity() const override;
+    virtual FigureKind kind() const override;
+    virtual size_t vertexCount() const override;
+    virtual Point<T> getVertex(size_t index) const override;
 
     ~Square() = default;
 };
@@ -32,43 +37,39 @@ public:
 // Конструктор по умолчанию
 template <Scalar T>
 Square<T>::Square() 
-    : p1(std::make_unique<Point<T>>(T(0), T(0))),
-      p2(std::make_unique<Point<T>>(T(1), T(0))),
-      p3(std::make_unique<Point<T>>(T(1), T(1))),
-      p4(std::make_unique<Point<T>>(T(0), T(1))) {}
+    : _points{
+          Point<T>(T(0), T(0)),
+          Point<T>(T(1), T(0)),
+          Point<T>(T(1), T(1)),
+          Point<T>(T(0), T(1))
+      } {}
 
 // Конструктор с параметрами
 template <Scalar T>
 Square<T>::Square(Point<T> a, Point<T> b, Point<T> c, Point<T> d)
-    : p1(std::make_unique<Point<T>>(a)),
-      p2(std::make_unique<Point<T>>(b)),
-      p3(std::make_unique<Point<T>>(c)),
-      p4(std::make_unique<Point<T>>(d)) {}
+    : _points{a, b, c, d} {}
+
+// Конструктор из значимого типа
+template <Scalar T>
+Square<T>::Square(const SquareShape<T>& shape)
+    : _points(shape.points) {}
 
 // Конструктор копирования
 template <Scalar T>
 Square<T>::Square(const Square& other)
-    : p1(std::make_unique<Point<T>>(*other.p1)),
-      p2(std::make_unique<Point<T>>(*other.p2)),
-      p3(std::make_unique<Point<T>>(*other.p3)),
-      p4(std::make_unique<Point<T>>(*other.p4)) {}
+    : Figure<T>(other), _points(other._points) {}
 
 // Конструктор перемещения
 template <Scalar T>
 Square<T>::Square(Square&& other) noexcept
-    : p1(std::move(other.p1)),
-      p2(std::move(other.p2)),
-      p3(std::move(other.p3)),
-      p4(std::move(other.p4)) {}
+    : Figure<T>(std::move(other)), _points(std::move(other._points)) {}
 
 // Оператор присваивания копированием
 template <Scalar T>
 Square<T>& Square<T>::operator=(const Square& other) {
     if (this != &other) {
-        p1 = std::make_unique<Point<T>>(*other.p1);
-        p2 = std::make_unique<Point<T>>(*other.p2);
-        p3 = std::make_unique<Point<T>>(*other.p3);
-        p4 = std::make_unique<Point<T>>(*other.p4);
+        Figure<T>::operator=(other);
+        _points = other._points;
     }
     return *this;
 }
@@ -77,10 +78,8 @@ Square<T>& Square<T>::operator=(const Square& other) {
 template <Scalar T>
 Square<T>& Square<T>::operator=(Square&& other) noexcept {
     if (this != &other) {
-        p1 = std::move(other.p1);
-        p2 = std::move(other.p2);
-        p3 = std::move(other.p3);
-        p4 = std::move(other.p4);
+        Figure<T>::operator=(std::move(other));
+        _points = std::move(other._points);
     }
     return *this;
 }
@@ -88,7 +87,7 @@ Square<T>& Square<T>::operator=(Square&& other) noexcept {
 // Вывод в поток
 template <Scalar T>
 void Square<T>::output(std::ostream& os) const {
-    os << "Square: " << *p1 << ", " << *p2 << ", " << *p3 << ", " << *p4;
+    os << "Square: " << _points[0] << ", " << _points[1] << ", " << _points[2] << ", " << _points[3];
 }
 
 // Ввод из потока
@@ -100,10 +99,8 @@ void Square<T>::input(std::istream& is) {
     }
     is >> a >> b >> c >> d;
     
-    p1 = std::make_unique<Point<T>>(a);
-    p2 = std::make_unique<Point<T>>(b);
-    p3 = std::make_unique<Point<T>>(c);
-    p4 = std::make_unique<Point<T>>(d);
+    _points = {a, b, c, d};
+    this->invalidateCache();
     
     if (!checkValidity()) {
         throw std::invalid_argument("Invalid square vertices provided!");
@@ -113,46 +110,36 @@ void Square<T>::input(std::istream& is) {
 // Центроид
 template <Scalar T>
 Point<T> Square<T>::getCentroid() const {
-    T x = (p1->getX() + p2->getX() + p3->getX() + p4->getX()) / 4;
-    T y = (p1->getY() + p2->getY() + p3->getY() + p4->getY()) / 4;
-    return Point<T>(x, y);
+    return vertexCentroid(_points);
 }
 
 // Площадь
 template <Scalar T>
 double Square<T>::calculateArea() const {
-    // Вычисляем длину стороны
-    double side = std::sqrt(
-        std::pow(p2->getX() - p1->getX(), 2) + 
-        std::pow(p2->getY() - p1->getY(), 2)
-    );
-    return side * side;
+    return squareArea(_points);
 }
 
 // Оператор приведения к double
 template <Scalar T>
 Square<T>::operator double() const {
-    return calculateArea();
+    return this->area();
 }
 
 // Оператор сравнения
 template <Scalar T>
 bool Square<T>::operator==(const Figure<T>& otherFig) const {
-    const Square* otherSquare = dynamic_cast<const Square*>(&otherFig);
-    if (!otherSquare) return false;
+    // Вид проверяется без dynamic_cast
+    if (otherFig.kind() != FigureKind::Square) return false;
+    const Square* otherSquare = static_cast<const Square*>(&otherFig);
     
     // Проверяем все возможные циклические сдвиги вершин
-    const Point<T>* thisPoints[] = {p1.get(), p2.get(), p3.get(), p4.get()};
-    const Point<T>* otherPoints[] = {
-        otherSquare->p1.get(), otherSquare->p2.get(), 
-        otherSquare->p3.get(), otherSquare->p4.get()
-    };
+    const std::array<Point<T>, 4>& otherPoints = otherSquare->_points;
     
     for (int offset = 0; offset < 4; ++offset) {
         bool isMatch = true;
         for (int i = 0; i < 4; ++i) {
             int shiftedIndex = (i + offset) % 4;
-            if (!(*thisPoints[i] == *otherPoints[shiftedIndex])) {
+            if (!(_points[i] == otherPoints[shiftedIndex])) {
                 isMatch = false;
                 break;
             }
@@ -171,46 +158,26 @@ bool Square<T>::operator!=(const Figure<T>& otherFig) const {
 // Проверка валидности
 template <Scalar T>
 bool Square<T>::checkValidity() const {
-    // Проверка на уникальность точек
-    const Point<T>* points[] = {p1.get(), p2.get(), p3.get(), p4.get()};
-    for (int i = 0; i < 4; ++i) {
-        for (int j = i + 1; j < 4; ++j) {
-            if (*points[i] == *points[j]) {
-                return false;
-            }
-        }
-    }
-    
-    // Вычисляем длины сторон
-    double side1 = std::sqrt(
-        std::pow(p2->getX() - p1->getX(), 2) + 
-        std::pow(p2->getY() - p1->getY(), 2)
-    );
-    double side2 = std::sqrt(
-        std::pow(p3->getX() - p2->getX(), 2) + 
-        std::pow(p3->getY() - p2->getY(), 2)
-    );
-    double side3 = std::sqrt(
-        std::pow(p4->getX() - p3->getX(), 2) + 
-        std::pow(p4->getY() - p3->getY(), 2)
-    );
-    double side4 = std::sqrt(
-        std::pow(p1->getX() - p4->getX(), 2) + 
-        std::pow(p1->getY() - p4->getY(), 2)
-    );
-    
-    // Проверка равенства всех сторон
-    if (std::abs(side1 - side2) > EPS || 
-        std::abs(side2 - side3) > EPS || 
-        std::abs(side3 - side4) > EPS) {
-        return false;
-    }
-    
-    // Проверка прямых углов через скалярное произведение
-    double dot1 = (p2->getX() - p1->getX()) * (p4->getX() - p1->getX()) + 
-                  (p2->getY() - p1->getY()) * (p4->getY() - p1->getY());
-    
-    return std::abs(dot1) < EPS; // Скалярное произведение должно быть близко к 0 для прямого угла
+    return squareValid(_points);
+}
+
+// Вид фигуры
+template <Scalar T>
+FigureKind Square<T>::kind() const {
+    return FigureKind::Square;
+}
+
+// Количество вершин
+template <Scalar T>
+size_t Square<T>::vertexCount() const {
+    return 4;
+}
+
+// Доступ к вершине по индексу
+template <Scalar T>
+Point<T> Square<T>::getVertex(size_t index) const {
+    if (index >= 4) throw std::out_of_range("Vertex index out of bounds");
+    return _points[index];
 }
 
 #endif
\ No newline at end of file
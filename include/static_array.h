@@ -0,0 +1,285 @@
+#ifndef STATIC_FIGURE_ARRAY_H
+#define STATIC_FIGURE_ARRAY_H
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <iomanip>
+#include <algorithm>
+#include <variant>
+#include <vector>
+#include <type_traits>
+#include "figure.h"
+#include "triangle.h"
+#include "square.h"
+#include "rectangle.h"
+#include "parallel.h"
+#include "canonical.h"
+#include "ordering.h"
+
+// Фигура, хранимая по значению
+template <Scalar T>
+using FigureVariant = std::variant<Triangle<T>, Square<T>, Rectangle<T>>;
+
+// Шаблонный класс StaticFigureArray - массив фигур без виртуальной диспетчеризации.
+// Фигуры хранятся по значению в std::variant, операции вызываются через std::visit
+// с квалифицированными (невиртуальными) вызовами, поэтому горячие циклы встраиваются.
+// Публичный интерфейс совпадает с FigureArray, что позволяет сравнивать контейнеры. Отличия:
+// - stats() константный и считается за один проход O(n) (фигуры меняются на месте
+//   через operator[], поэтому поддерживаемых показателей и invalidateStats() нет);
+// - emplace создаёт фигуру в векторе вариантов, ссылка действительна до перевыделения или удаления;
+// - агрегаты массива вызывают вычисления фигур напрямую, поэтому setCaching влияет только на
+//   area(), centroid() и boundingBox() фигур, полученных через operator[] (и на ключи упорядочивания).
+template <typename T>
+class StaticFigureArray {
+private:
+    std::vector<FigureVariant<T>> _figures;
+
+    static constexpr size_t parallelChunkSize = 4096;
+
+    size_t chunkCount() const {
+        return (_figures.size() + parallelChunkSize - 1) / parallelChunkSize;
+    }
+
+    // Квалифицированный вызов F::method() не использует таблицу виртуальных функций
+    static double areaOf(const FigureVariant<T>& figure) {
+        return std::visit([](const auto& f) {
+            using F = std::decay_t<decltype(f)>;
+            return f.F::calculateArea();
+        }, figure);
+    }
+
+    static Point<T> centroidOf(const FigureVariant<T>& figure) {
+        return std::visit([](const auto& f) {
+            using F = std::decay_t<decltype(f)>;
+            return f.F::getCentroid();
+        }, figure);
+    }
+
+    static const Figure<T>& figureOf(const FigureVariant<T>& figure) {
+        return std::visit([](const auto& f) -> const Figure<T>& { return f; }, figure);
+    }
+
+    template <typename Key>
+    std::vector<ordering_detail::KeyedIndex> computeKeys(Key& key, SortOrder order, ThreadPool& pool) const {
+        return ordering_detail::computeKeys(_figures.size(), parallelChunkSize, [&](size_t i) {
+            return key(figureOf(_figures[i]));
+        }, order, pool);
+    }
+
+    void permute(const std::vector<ordering_detail::KeyedIndex>& order) {
+        ordering_detail::applyPermutation(_figures.data(), order);
+    }
+
+    std::vector<size_t> groupEqual(double quantum) const {
+        return groupEqualFigures(_figures.size(), [this](size_t i) -> const Figure<T>& { return figureOf(_figures[i]); }, quantum);
+    }
+
+public:
+    StaticFigureArray() {
+        _figures.reserve(4);
+    }
+
+    // Резервирование места под capacity фигур без перевыделений при последующих add
+    void reserve(size_t capacity) { _figures.reserve(capacity); }
+
+    // Добавление по значению
+    void add(const Triangle<T>& figure) { _figures.emplace_back(figure); }
+    void add(const Square<T>& figure) { _figures.emplace_back(figure); }
+    void add(const Rectangle<T>& figure) { _figures.emplace_back(figure); }
+
+    // Добавление копии фигуры, переданной через shared_ptr (совместимость с FigureArray)
+    void add(std::shared_ptr<Figure<T>> figure) {
+        if (!figure) throw std::invalid_argument("Null figure");
+        switch (figure->kind()) {
+            case FigureKind::Triangle:
+                _figures.emplace_back(static_cast<const Triangle<T>&>(*figure));
+                break;
+            case FigureKind::Square:
+                _figures.emplace_back(static_cast<const Square<T>&>(*figure));
+                break;
+            case FigureKind::Rectangle:
+                _figures.emplace_back(static_cast<const Rectangle<T>&>(*figure));
+                break;
+        }
+    }
+
+    // Создание фигуры на месте; ссылка действительна до следующего перевыделения или удаления
+    template <typename Kind, typename... Args>
+    Kind& emplace(Args&&... args) {
+        static_assert(std::is_same_v<Kind, Triangle<T>> || std::is_same_v<Kind, Square<T>> ||
+                      std::is_same_v<Kind, Rectangle<T>>, "Kind must be Triangle<T>, Square<T> or Rectangle<T>");
+        return std::get<Kind>(_figures.emplace_back(std::in_place_type<Kind>, std::forward<Args>(args)...));
+    }
+
+    // Операторы доступа
+    Figure<T>& operator[](size_t index) {
+        if (index >= _figures.size()) throw std::out_of_range("Index out of bounds");
+        return std::visit([](auto& f) -> Figure<T>& { return f; }, _figures[index]);
+    }
+
+    const Figure<T>& operator[](size_t index) const {
+        if (index >= _figures.size()) throw std::out_of_range("Index out of bounds");
+        return std::visit([](const auto& f) -> const Figure<T>& { return f; }, _figures[index]);
+    }
+
+    // Прямой доступ к варианту для std::visit в пользовательских циклах
+    const FigureVariant<T>& variant(size_t index) const {
+        if (index >= _figures.size()) throw std::out_of_range("Index out of bounds");
+        return _figures[index];
+    }
+
+    void erase(size_t index) {
+        if (index >= _figures.size()) throw std::out_of_range("Index invalid");
+        _figures.erase(_figures.begin() + static_cast<std::ptrdiff_t>(index));
+    }
+
+    void eraseUnordered(size_t index) {
+        if (index >= _figures.size()) throw std::out_of_range("Index invalid");
+        if (index + 1 != _figures.size()) {
+            _figures[index] = std::move(_figures.back());
+        }
+        _figures.pop_back();
+    }
+
+    template <typename Predicate>
+    size_t eraseIf(Predicate predicate) {
+        return std::erase_if(_figures, [&](const FigureVariant<T>& figure) {
+            return std::visit([&](const auto& f) { return predicate(static_cast<const Figure<T>&>(f)); }, figure);
+        });
+    }
+
+    size_t size() const { return _figures.size(); }
+
+    // Сводные показатели (как FigureArray::stats), один проход без виртуальных вызовов
+    FigureArrayStats<T> stats() const {
+        FigureArrayStats<T> result;
+        result.count = _figures.size();
+        KahanSum area;
+        for (size_t i = 0; i < _figures.size(); ++i) {
+            std::visit([&](const auto& f) {
+                using F = std::decay_t<decltype(f)>;
+                area.add(f.F::calculateArea());
+                ++result.kindCounts[static_cast<size_t>(f.F::kind())];
+                for (size_t v = 0; v < f.F::vertexCount(); ++v) {
+                    Point<T> vertex = f.F::getVertex(v);
+                    if (i == 0 && v == 0) {
+                        result.bounds = BoundingBox<T>{vertex.getX(), vertex.getY(), vertex.getX(), vertex.getY()};
+                    } else {
+                        result.bounds.expand(vertex);
+                    }
+                }
+            }, _figures[i]);
+        }
+        result.totalArea = area.result();
+        return result;
+    }
+
+    // Упорядочивание по ключу (ordering.h), как в FigureArray
+    template <typename Key>
+    void sortBy(Key key, SortOrder order = SortOrder::Ascending, ThreadPool& pool = defaultThreadPool()) {
+        std::vector<ordering_detail::KeyedIndex> entries = computeKeys(key, order, pool);
+        parallelSort(entries, ordering_detail::keyedLess, pool);
+        permute(entries);
+    }
+
+    template <typename Key>
+    void topK(size_t k, Key key, ThreadPool& pool = defaultThreadPool()) {
+        k = std::min(k, _figures.size());
+        if (k == 0) return;
+        permute(ordering_detail::topKOrder(computeKeys(key, SortOrder::Descending, pool), k, pool));
+    }
+
+    template <typename Key>
+    void nthElement(size_t n, Key key, SortOrder order = SortOrder::Ascending, ThreadPool& pool = defaultThreadPool()) {
+        if (n >= _figures.size()) throw std::out_of_range("Index out of bounds");
+        std::vector<ordering_detail::KeyedIndex> entries = computeKeys(key, order, pool);
+        std::nth_element(entries.begin(), entries.begin() + static_cast<std::ptrdiff_t>(n), entries.end(),
+                         ordering_detail::keyedLess);
+        permute(entries);
+    }
+
+    // Поиск и удаление повторов (canonical.h), как в FigureArray
+    std::vector<std::vector<size_t>> findDuplicates(double quantum = canonicalQuantum) const {
+        return duplicateGroups(groupEqual(quantum));
+    }
+
+    size_t dedup(double quantum = canonicalQuantum) {
+        std::vector<size_t> group = groupEqual(quantum);
+        size_t position = 0;
+        return eraseIf([&](const Figure<T>&) {
+            size_t i = position++;
+            return group[i] != i;
+        });
+    }
+
+    void setCaching(bool enabled) {
+        for (auto& figure : _figures) {
+            std::visit([&](auto& f) { f.setCaching(enabled); }, figure);
+        }
+    }
+
+    void displayAreas() const {
+        std::cout << std::fixed << std::setprecision(2);
+        for (size_t i = 0; i < _figures.size(); ++i) {
+            std::cout << i << ": " << (*this)[i]
+                      << " | Area = " << areaOf(_figures[i]) << '\n';
+        }
+        std::cout.flush();
+    }
+
+    void displayCentroids() const {
+        for (size_t i = 0; i < _figures.size(); ++i) {
+            Point<T> centroid = centroidOf(_figures[i]);
+            std::cout << i << ": Centroid = (" << centroid.getX()
+                      << ", " << centroid.getY() << ")" << '\n';
+        }
+        std::cout.flush();
+    }
+
+    double computeTotalArea() const {
+        double total = 0.0;
+        for (const auto& figure : _figures) {
+            total += areaOf(figure);
+        }
+        return total;
+    }
+
+    // Параллельные версии агрегатов (те же фрагменты и порядок суммирования, что и в FigureArray)
+    double computeTotalAreaParallel(ThreadPool& pool = defaultThreadPool()) const {
+        std::vector<double> partial(chunkCount());
+        pool.parallelFor(partial.size(), [&](size_t chunk) {
+            size_t end = std::min(_figures.size(), (chunk + 1) * parallelChunkSize);
+            KahanSum sum;
+            for (size_t i = chunk * parallelChunkSize; i < end; ++i) {
+                sum.add(areaOf(_figures[i]));
+            }
+            partial[chunk] = sum.result();
+        });
+        return pairwiseSum(partial.data(), partial.size());
+    }
+
+    std::vector<double> computeAreasParallel(ThreadPool& pool = defaultThreadPool()) const {
+        std::vector<double> areas(_figures.size());
+        pool.parallelFor(chunkCount(), [&](size_t chunk) {
+            size_t end = std::min(_figures.size(), (chunk + 1) * parallelChunkSize);
+            for (size_t i = chunk * parallelChunkSize; i < end; ++i) {
+                areas[i] = areaOf(_figures[i]);
+            }
+        });
+        return areas;
+    }
+
+    std::vector<Point<T>> computeCentroidsParallel(ThreadPool& pool = defaultThreadPool()) const {
+        std::vector<Point<T>> centroids(_figures.size());
+        pool.parallelFor(chunkCount(), [&](size_t chunk) {
+            size_t end = std::min(_figures.size(), (chunk + 1) * parallelChunkSize);
+            for (size_t i = chunk * parallelChunkSize; i < end; ++i) {
+                centroids[i] = centroidOf(_figures[i]);
+            }
+        });
+        return centroids;
+    }
+};
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+#include "figure.h"
+#include "parallel.h"
+
+// Статистика площадей по видам фигур за один параллельный проход.
+//
+// Для каждого вида (и для всех фигур вместе) считаются число, сумма с компенсацией, минимум,
+// максимум, среднее, гистограмма по заданным границам и приближённые квантили.
+// Массив делится на фрагменты по statisticsChunkSize фигур; фрагменты распределяются по
+// statisticsStripes частичным состояниям (полоса s обрабатывает фрагменты s, s + stripes, ...),
+// состояния объединяются в фиксированном порядке. Разбиение не зависит от числа потоков,
+// поэтому и результат от него не зависит.
+
+// Квантильный эскиз с относительной точностью (логарифмические корзины, как в DDSketch).
+// Значение v > minIndexable попадает в корзину i = ceil(log_gamma(v)), gamma = (1 + a) / (1 - a);
+// оценка квантиля отличается от точного значения не более чем в (1 ± a) раз.
+// Значения не больше minIndexable (вырожденные фигуры) учитываются в отдельной нулевой корзине.
+class QuantileSketch {
+private:
+    static constexpr double minIndexable = EPS * EPS;
+
+    double _relativeAccuracy;
+    double _logGamma;
+    size_t _zeroCount = 0;
+    size_t _count = 0;
+    long _offset = 0;            // Номер корзины _bins[0]
+    std::vector<size_t> _bins;
+
+    long indexOf(double value) const {
+        return static_cast<long>(std::ceil(std::log(value) / _logGamma));
+    }
+
+    // Расширение плотного массива корзин до [first, last]
+    void cover(long first, long last) {
+        if (_bins.empty()) {
+            _offset = first;
+            _bins.assign(static_cast<size_t>(last - first + 1), 0);
+            return;
+        }
+        long currentLast = _offset + static_cast<long>(_bins.size()) - 1;
+        if (first < _offset) {
+            _bins.insert(_bins.begin(), static_cast<size_t>(_offset - first), 0);
+            _offset = first;
+        }
+        if (last > currentLast) {
+            _bins.resize(_bins.size() + static_cast<size_t>(last - currentLast), 0);
+        }
+    }
+
+public:
+    explicit QuantileSketch(double relativeAccuracy = 0.01) : _relativeAccuracy(relativeAccuracy) {
+        if (!(relativeAccuracy > 0 && relativeAccuracy < 1)) {
+            throw std::invalid_argument("Relative accuracy must be in (0, 1)");
+        }
+        _logGamma = std::log((1 + relativeAccuracy) / (1 - relativeAccuracy));
+    }
+
+    void add(double value) {
+        ++_count;
+        if (!(value > minIndexable)) {
+            ++_zeroCount;
+            return;
+        }
+        long index = indexOf(value);
+        cover(index, index);
+        ++_bins[static_cast<size_t>(index - _offset)];
+    }
+
+    void merge(const QuantileSketch& other) {
+        if (other._logGamma != _logGamma) throw std::invalid_argument("Sketch accuracy mismatch");
+        _count += other._count;
+        _zeroCount += other._zeroCount;
+        if (other._bins.empty()) return;
+        cover(other._offset, other._offset + static_cast<long>(other._bins.size()) - 1);
+        for (size_t i = 0; i < other._bins.size(); ++i) {
+            _bins[static_cast<size_t>(other._offset - _offset) + i] += other._bins[i];
+        }
+    }
+
+    size_t count() const { return _count; }
+    double relativeAccuracy() const { return _relativeAccuracy; }
+
+    // Квантиль q из [0, 1]: оценка значения с рангом floor(q * (count - 1)) по возрастанию
+    double quantile(double q) const {
+        if (_count == 0) return std::numeric_limits<double>::quiet_NaN();
+        q = std::clamp(q, 0.0, 1.0);
+        size_t rank = static_cast<size_t>(q * static_cast<double>(_count - 1));
+        if (rank < _zeroCount) return 0.0;
+        size_t seen = _zeroCount;
+        for (size_t i = 0; i < _bins.size(); ++i) {
+            seen += _bins[i];
+            if (seen > rank) {
+                // Середина корзины (gamma^(i-1), gamma^i] в смысле относительной ошибки
+                double upper = std::exp(static_cast<double>(_offset + static_cast<long>(i)) * _logGamma);
+                return upper * 2 / (1 + std::exp(_logGamma));
+            }
+        }
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+};
+
+// Параметры прохода
+struct StatisticsOptions {
+    // Возрастающие границы корзин гистограммы площадей; корзина b - [edges[b-1], edges[b]),
+    // корзины 0 и edges.size() принимают значения вне диапазона. Пустой список - без гистограммы.
+    std::vector<double> histogramEdges;
+    double relativeAccuracy = 0.01;  // Точность квантилей
+};
+
+// Статистика площадей одной группы фигур
+struct AreaStatistics {
+    size_t count = 0;
+    double sum = 0.0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    std::vector<size_t> histogram;
+    QuantileSketch sketch;
+
+    explicit AreaStatistics(const StatisticsOptions& options = StatisticsOptions())
+        : histogram(options.histogramEdges.empty() ? 0 : options.histogramEdges.size() + 1, 0),
+          sketch(options.relativeAccuracy) {}
+
+    double mean() const {
+        return count == 0 ? std::numeric_limits<double>::quiet_NaN() : sum / static_cast<double>(count);
+    }
+
+    // Приближённый квантиль, ограниченный точными min и max
+    double quantile(double q) const {
+        if (count == 0) return std::numeric_limits<double>::quiet_NaN();
+        return std::clamp(sketch.quantile(q), min, max);
+    }
+};
+
+// Итог: по видам фигур (индекс - FigureKind) и по всем фигурам
+struct FigureStatistics {
+    std::array<AreaStatistics, 3> byKind;
+    AreaStatistics all;
+
+    const AreaStatistics& of(FigureKind kind) const { return byKind[static_cast<size_t>(kind)]; }
+};
+
+namespace statistics_detail {
+
+inline constexpr size_t statisticsChunkSize = 4096;
+inline constexpr size_t statisticsStripes = 64;
+
+// Частичное состояние одной группы: сумма накапливается с компенсацией
+struct PartialStatistics {
+    AreaStatistics stats;
+    KahanSum sum;
+
+    explicit PartialStatistics(const StatisticsOptions& options) : stats(options) {}
+
+    void add(double area, const std::vector<double>& edges) {
+        ++stats.count;
+        sum.add(area);
+        stats.min = std::min(stats.min, area);
+        stats.max = std::max(stats.max, area);
+        if (!edges.empty()) {
+            ++stats.histogram[static_cast<size_t>(std::upper_bound(edges.begin(), edges.end(), area) - edges.begin())];
+        }
+        stats.sketch.add(area);
+    }
+};
+
+inline void mergeInto(AreaStatistics& target, const AreaStatistics& source) {
+    target.count += source.count;
+    target.min = std::min(target.min, source.min);
+    target.max = std::max(target.max, source.max);
+    for (size_t b = 0; b < target.histogram.size(); ++b) {
+        target.histogram[b] += source.histogram[b];
+    }
+    target.sketch.merge(source.sketch);
+}
+
+} // namespace statistics_detail
+
+// Проход по контейнеру с size() и operator[] (FigureArray, StaticFigureArray, ConcurrentFigureArray)
+template <typename Array>
+FigureStatistics computeFigureStatistics(const Array& array, const StatisticsOptions& options = StatisticsOptions(),
+                                         ThreadPool& pool = defaultThreadPool()) {
+    using namespace statistics_detail;
+    if (!std::is_sorted(options.histogramEdges.begin(), options.histogramEdges.end())) {
+        throw std::invalid_argument("Histogram edges must be sorted");
+    }
+
+    size_t count = array.size();
+    size_t chunks = (count + statisticsChunkSize - 1) / statisticsChunkSize;
+    size_t stripes = std::min(chunks, statisticsStripes);
+
+    std::vector<std::array<PartialStatistics, 3>> partial;
+    partial.reserve(stripes);
+    for (size_t s = 0; s < stripes; ++s) {
+        partial.push_back({PartialStatistics(options), PartialStatistics(options), PartialStatistics(options)});
+    }
+
+    pool.parallelFor(stripes, [&](size_t stripe) {
+        auto& groups = partial[stripe];
+        for (size_t chunk = stripe; chunk < chunks; chunk += stripes) {
+            size_t end = std::min(count, (chunk + 1) * statisticsChunkSize);
+            for (size_t i = chunk * statisticsChunkSize; i < end; ++i) {
+                const auto& figure = array[i];
+                groups[static_cast<size_t>(figure.kind())].add(static_cast<double>(figure), options.histogramEdges);
+            }
+        }
+    });
+
+    FigureStatistics result{{AreaStatistics(options), AreaStatistics(options), AreaStatistics(options)},
+                            AreaStatistics(options)};
+    KahanSum allSum;
+    for (size_t kind = 0; kind < 3; ++kind) {
+        KahanSum kindSum;
+        for (const auto& groups : partial) {
+            mergeInto(result.byKind[kind], groups[kind].stats);
+            kindSum.add(groups[kind].sum.result());
+        }
+        result.byKind[kind].sum = kindSum.result();
+        allSum.add(result.byKind[kind].sum);
+        mergeInto(result.all, result.byKind[kind]);
+    }
+    result.all.sum = allSum.result();
+    return result;
+}
+
+#endif
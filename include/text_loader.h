@@ -0,0 +1,200 @@
+#ifndef TEXT_LOADER_H
+#define TEXT_LOADER_H
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <charconv>
+#include <cstring>
+#include <algorithm>
+#include <system_error>
+#include "figure.h"
+#include "triangle.h"
+#include "square.h"
+#include "rectangle.h"
+#include "array.h"
+#include "column_store.h"
+#include "mapped_file.h"
+
+// Пакетная загрузка фигур из текста без потоков ввода-вывода.
+//
+// Формат: одна фигура на строку - "kind x y x y ...", где kind - triangle, square или rectangle,
+// за ним 3 или 4 пары координат. Разделители - пробелы, табуляции и запятые.
+// Пустые строки и строки, начинающиеся с '#', пропускаются.
+// Числа разбираются std::from_chars (без локали). Вершины проверяются теми же ограничениями,
+// что и checkValidity() классов фигур; ошибочные и невалидные строки не прерывают загрузку,
+// а попадают в отчёт и не передаются в sink.
+
+// Ошибка в строке входных данных
+struct TextLoadError {
+    size_t line;          // Номер строки, начиная с 1
+    std::string message;
+};
+
+// Итог загрузки
+struct TextLoadResult {
+    size_t loaded = 0;                 // Число загруженных фигур
+    size_t lines = 0;                  // Число обработанных строк
+    size_t errorCount = 0;             // Число ошибочных строк
+    std::vector<TextLoadError> errors; // Первые maxErrors ошибок
+
+    bool ok() const { return errorCount == 0; }
+};
+
+namespace text_loader_detail {
+
+inline bool isSeparator(char c) {
+    return c == ' ' || c == '\t' || c == ',' || c == '\r';
+}
+
+// Следующая лексема строки; пустая в конце строки
+inline std::string_view nextToken(const char*& cursor, const char* end) {
+    while (cursor < end && isSeparator(*cursor)) ++cursor;
+    const char* start = cursor;
+    while (cursor < end && !isSeparator(*cursor)) ++cursor;
+    return std::string_view(start, static_cast<size_t>(cursor - start));
+}
+
+inline bool parseKind(std::string_view token, FigureKind& kind) {
+    if (token == "triangle") kind = FigureKind::Triangle;
+    else if (token == "square") kind = FigureKind::Square;
+    else if (token == "rectangle") kind = FigureKind::Rectangle;
+    else return false;
+    return true;
+}
+
+template <Scalar T>
+bool parseNumber(std::string_view token, T& value) {
+    const char* first = token.data();
+    const char* last = token.data() + token.size();
+    if (first != last && *first == '+') {
+        ++first;  // from_chars не принимает ведущий '+'
+        if (first != last && *first == '-') return false;
+    }
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    return ec == std::errc() && ptr == last && first != last;
+}
+
+// Проверка вершин записи (triangleValid/squareValid/rectangleValid, как в checkValidity())
+template <Scalar T>
+bool recordValid(FigureKind kind, const Point<T>* points) {
+    switch (kind) {
+        case FigureKind::Triangle:
+            return triangleValid(std::array<Point<T>, 3>{points[0], points[1], points[2]});
+        case FigureKind::Square:
+            return squareValid(std::array<Point<T>, 4>{points[0], points[1], points[2], points[3]});
+        case FigureKind::Rectangle:
+            return rectangleValid(std::array<Point<T>, 4>{points[0], points[1], points[2], points[3]});
+    }
+    return false;
+}
+
+// Разбор одной строки; при ошибке возвращает сообщение, иначе пустую строку
+template <Scalar T>
+std::string parseLine(const char* cursor, const char* end, FigureKind& kind, Point<T>* points, size_t& count) {
+    std::string_view token = nextToken(cursor, end);
+    if (!parseKind(token, kind)) {
+        return "unknown figure kind '" + std::string(token) + "'";
+    }
+    std::string_view kindToken = token;
+
+    count = kind == FigureKind::Triangle ? 3 : 4;
+    for (size_t v = 0; v < count; ++v) {
+        T coordinates[2];
+        for (T& coordinate : coordinates) {
+            token = nextToken(cursor, end);
+            if (token.empty()) return "expected " + std::to_string(count * 2) + " coordinates";
+            if (!parseNumber(token, coordinate)) return "invalid number '" + std::string(token) + "'";
+        }
+        points[v] = Point<T>(coordinates[0], coordinates[1]);
+    }
+    if (!nextToken(cursor, end).empty()) return "unexpected trailing data";
+    if (!recordValid(kind, static_cast<const Point<T>*>(points))) return "invalid " + std::string(kindToken) + " vertices";
+    return std::string();
+}
+
+// Верхняя оценка числа записей (число строк) для резервирования памяти
+inline size_t estimateRecords(std::string_view text) {
+    return static_cast<size_t>(std::count(text.begin(), text.end(), '\n')) + 1;
+}
+
+} // namespace text_loader_detail
+
+// Разбор буфера: для каждой корректной строки с валидными вершинами вызывается sink(kind, points, count)
+template <Scalar T, typename Sink>
+TextLoadResult parseFiguresText(std::string_view text, Sink sink, size_t maxErrors = 100) {
+    TextLoadResult result;
+    const char* cursor = text.data();
+    const char* end = text.data() + text.size();
+    Point<T> points[4];
+
+    while (cursor < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(cursor, '\n', static_cast<size_t>(end - cursor)));
+        if (!lineEnd) lineEnd = end;
+        ++result.lines;
+
+        const char* first = cursor;
+        while (first < lineEnd && text_loader_detail::isSeparator(*first)) ++first;
+        if (first < lineEnd && *first != '#') {
+            FigureKind kind;
+            size_t count = 0;
+            std::string error = text_loader_detail::parseLine(first, lineEnd, kind, points, count);
+            if (error.empty()) {
+                sink(kind, static_cast<const Point<T>*>(points), count);
+                ++result.loaded;
+            } else {
+                ++result.errorCount;
+                if (result.errors.size() < maxErrors) {
+                    result.errors.push_back(TextLoadError{result.lines, std::move(error)});
+                }
+            }
+        }
+        cursor = lineEnd + 1;
+    }
+    return result;
+}
+
+// Загрузка в колоночное хранилище
+template <Scalar T>
+TextLoadResult loadFiguresText(std::string_view text, FigureColumnStore<T>& store, size_t maxErrors = 100) {
+    // Резервирование только для пустого хранилища: повторные загрузки небольших буферов
+    // не должны перевыделять память на каждом вызове
+    if (store.size() == 0) {
+        size_t records = text_loader_detail::estimateRecords(text);
+        store.reserve(records, records * 4);
+    }
+    return parseFiguresText<T>(text, [&](FigureKind kind, const Point<T>* points, size_t count) {
+        store.add(kind, points, count);
+    }, maxErrors);
+}
+
+// Загрузка в FigureArray (фигуры создаются через emplace)
+template <Scalar T, typename Ownership>
+TextLoadResult loadFiguresText(std::string_view text, FigureArray<T, Ownership>& array, size_t maxErrors = 100) {
+    if (array.size() == 0) {
+        array.reserve(text_loader_detail::estimateRecords(text));
+    }
+    return parseFiguresText<T>(text, [&](FigureKind kind, const Point<T>* p, size_t) {
+        switch (kind) {
+            case FigureKind::Triangle:
+                array.template emplace<Triangle<T>>(p[0], p[1], p[2]);
+                break;
+            case FigureKind::Square:
+                array.template emplace<Square<T>>(p[0], p[1], p[2], p[3]);
+                break;
+            case FigureKind::Rectangle:
+                array.template emplace<Rectangle<T>>(p[0], p[1], p[2], p[3]);
+                break;
+        }
+    }, maxErrors);
+}
+
+// Загрузка файла через отображение в память (Target - FigureColumnStore<T> или FigureArray<T>)
+template <Scalar T, typename Target>
+TextLoadResult loadFiguresTextFile(const std::string& path, Target& target, size_t maxErrors = 100) {
+    MappedFile file(path);
+    return loadFiguresText<T>(std::string_view(file.data(), file.size()), target, maxErrors);
+}
+
+#endif
@@ -2,17 +2,19 @@
 #define TRIANGLE_H
 
 #include "figure.h"
-#include <memory>
+#include "geometry.h"
+#include <array>
 #include <cmath>
 
 template <Scalar T>
 class Triangle : public Figure<T> {
 private:
-    std::unique_ptr<Point<T>> p1, p2, p3;
+    std::array<Point<T>, 3> _points;
 
 public:
     Triangle();
     Triangle(Point<T> a, Point<T> b, Point<T> c);
+    explicit Triangle(const TriangleShape<T>& shape);
     Triangle(const Triangle& other);
     Triangle(Triangle&& other) noexcept;
     Triangle& operator=(const Triangle& other);
@@ -26,6 +28,9 @@ public:
     virtual bool operator==(const Figure<T>& otherFig) const override;
     virtual bool operator!=(const Figure<T>& otherFig) const override;
     virtual bool checkValidity() const override;
+    virtual FigureKind kind() const override;
+    virtual size_t vertexCount() const override;
+    virtual Point<T> getVertex(size_t index) const override;
  
     ~Triangle() = default;
 };
@@ -33,38 +38,38 @@ public:
 // Конструктор по умолчанию
 template <Scalar T>
 Triangle<T>::Triangle() 
-    : p1(std::make_unique<Point<T>>(T(0), T(0))),
-      p2(std::make_unique<Point<T>>(T(1), T(0))),
-      p3(std::make_unique<Point<T>>(T(0), T(1))) {}
+    : _points{
+          Point<T>(T(0), T(0)),
+          Point<T>(T(1), T(0)),
+          Point<T>(T(0), T(1))
+      } {}
 
 // Конструктор с параметрами
 template <Scalar T>
 Triangle<T>::Triangle(Point<T> a, Point<T> b, Point<T> c)
-    : p1(std::make_unique<Point<T>>(a)),
-      p2(std::make_unique<Point<T>>(b)),
-      p3(std::make_unique<Point<T>>(c)) {}
+    : _points{a, b, c} {}
+
+// Конструктор из значимого типа
+template <Scalar T>
+Triangle<T>::Triangle(const TriangleShape<T>& shape)
+    : _points(shape.points) {}
 
 // Конструктор копирования
 template <Scalar T>
 Triangle<T>::Triangle(const Triangle& other)
-    : p1(std::make_unique<Point<T>>(*other.p1)),
-      p2(std::make_unique<Point<T>>(*other.p2)),
-      p3(std::make_unique<Point<T>>(*other.p3)) {}
+    : Figure<T>(other), _points(other._points) {}
 
 // Конструктор перемещения
 template <Scalar T>
 Triangle<T>::Triangle(Triangle&& other) noexcept
-    : p1(std::move(other.p1)),
-      p2(std::move(other.p2)),
-      p3(std::move(other.p3)) {}
+    : Figure<T>(std::move(other)), _points(std::move(other._points)) {}
 
 // Оператор присваивания копированием
 template <Scalar T>
 Triangle<T>& Triangle<T>::operator=(const Triangle& other) {
     if (this != &other) {
-        p1 = std::make_unique<Point<T>>(*other.p1);
-        p2 = std::make_unique<Point<T>>(*other.p2);
-        p3 = std::make_unique<Point<T>>(*other.p3);
+        Figure<T>::operator=(other);
+        _points = other._points;
     }
     return *this;
 }
@@ -73,9 +78,8 @@ Triangle<T>& Triangle<T>::operator=(const Triangle& other) {
 template <Scalar T>
 Triangle<T>& Triangle<T>::operator=(Triangle&& other) noexcept {
     if (this != &other) {
-        p1 = std::move(other.p1);
-        p2 = std::move(other.p2);
-        p3 = std::move(other.p3);
+        Figure<T>::operator=(std::move(other));
+        _points = std::move(other._points);
     }
     return *this;
 }
@@ -83,7 +87,7 @@ Triangle<T>& Triangle<T>::operator=(Triangle&& other) noexcept {
 // Вывод в поток
 template <Scalar T>
 void Triangle<T>::output(std::ostream& os) const {
-    os << "Triangle: " << *p1 << ", " << *p2 << ", " << *p3;
+    os << "Triangle: " << _points[0] << ", " << _points[1] << ", " << _points[2];
 }
 
 // Ввод из потока
@@ -95,9 +99,8 @@ void Triangle<T>::input(std::istream& is) {
     }
     is >> a >> b >> c;
     
-    p1 = std::make_unique<Point<T>>(a);
-    p2 = std::make_unique<Point<T>>(b);
-    p3 = std::make_unique<Point<T>>(c);
+    _points = {a, b, c};
+    this->invalidateCache();
     
     if (!checkValidity()) {
         throw std::invalid_argument("Invalid triangle vertices provided!");
@@ -107,45 +110,36 @@ void Triangle<T>::input(std::istream& is) {
 // Центроид
 template <Scalar T>
 Point<T> Triangle<T>::getCentroid() const {
-    T x = (p1->getX() + p2->getX() + p3->getX()) / 3;
-    T y = (p1->getY() + p2->getY() + p3->getY()) / 3;
-    return Point<T>(x, y);
+    return vertexCentroid(_points);
 }
 
 // Площадь (формула Герона)
 template <Scalar T>
 double Triangle<T>::calculateArea() const {
-    double a = std::sqrt(std::pow(p2->getX() - p1->getX(), 2) + std::pow(p2->getY() - p1->getY(), 2));
-    double b = std::sqrt(std::pow(p3->getX() - p2->getX(), 2) + std::pow(p3->getY() - p2->getY(), 2));
-    double c = std::sqrt(std::pow(p1->getX() - p3->getX(), 2) + std::pow(p1->getY() - p3->getY(), 2));
-    
-    double s = (a + b + c) / 2;
-    return std::sqrt(s * (s - a) * (s - b) * (s - c));
+    return triangleArea(_points);
 }
 
 // Оператор приведения к double
 template <Scalar T>
 Triangle<T>::operator double() const {
-    return calculateArea();
+    return this->area();
 }
 
 // Оператор сравнения
 template <Scalar T>
 bool Triangle<T>::operator==(const Figure<T>& otherFig) const {
-    const Triangle* otherTri = dynamic_cast<const Triangle*>(&otherFig);
-    if (!otherTri) return false;
+    // Вид проверяется без dynamic_cast
+    if (otherFig.kind() != FigureKind::Triangle) return false;
+    const Triangle* otherTri = static_cast<const Triangle*>(&otherFig);
     
     // Проверяем все возможные циклические сдвиги вершин
-    const Point<T>* thisPoints[] = {p1.get(), p2.get(), p3.get()};
-    const Point<T>* otherPoints[] = {
-        otherTri->p1.get(), otherTri->p2.get(), otherTri->p3.get()
-    };
+    const std::array<Point<T>, 3>& otherPoints = otherTri->_points;
     
     for (int offset = 0; offset < 3; ++offset) {
         bool isMatch = true;
         for (int i = 0; i < 3; ++i) {
             int shiftedIndex = (i + offset) % 3;
-            if (!(*thisPoints[i] == *otherPoints[shiftedIndex])) {
+            if (!(_points[i] == otherPoints[shiftedIndex])) {
                 isMatch = false;
                 break;
             }
@@ -164,19 +158,26 @@ bool Triangle<T>::operator!=(const Figure<T>& otherFig) const {
 // Проверка валидности
 template <Scalar T>
 bool Triangle<T>::checkValidity() const {
-    // Проверка на уникальность точек
-    const Point<T>* points[] = {p1.get(), p2.get(), p3.get()};
-    for (int i = 0; i < 3; ++i) {
-        for (int j = i + 1; j < 3; ++j) {
-            if (*points[i] == *points[j]) {
-                return false;
-            }
-        }
-    }
-    
-    // Проверка что точки не лежат на одной прямой
-    double area = calculateArea();
-    return area > EPS; // Площадь должна быть положительной
+    return triangleValid(_points);
+}
+
+// Вид фигуры
+template <Scalar T>
+FigureKind Triangle<T>::kind() const {
+    return FigureKind::Triangle;
+}
+
+// Количество вершин
+template <Scalar T>
+size_t Triangle<T>::vertexCount() const {
+    return 3;
+}
+
+// Доступ к вершине по индексу
+template <Scalar T>
+Point<T> Triangle<T>::getVertex(size_t index) const {
+    if (index >= 3) throw std::out_of_range("Vertex index out of bounds");
+    return _points[index];
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,287 @@
+#ifndef UNION_AREA_H
+#define UNION_AREA_H
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <cstddef>
+#include "figure.h"
+#include "parallel.h"
+#include "collision.h"
+
+// Площадь объединения фигур: перекрытия учитываются один раз (computeTotalArea их суммирует).
+//
+// Фигуры разбиваются на компоненты связности по пересечениям (findIntersectingPairs).
+// Площадь объединения - сумма площадей компонент, компоненты считаются параллельно.
+//   - Одиночная фигура - её собственная площадь.
+//   - Компонента из осевых прямоугольников и квадратов - заметание по X с деревом отрезков
+//     по сжатым Y-координатам (счётчик покрытия и покрытая длина в узле), O(m log m).
+//   - Остальные компоненты (треугольники, повёрнутые фигуры) - заметание по X с событиями
+//     в вершинах и точках пересечения рёбер. Между соседними событиями порядок рёбер не
+//     меняется, поэтому длина сечения объединения линейна по x и площадь полосы равна
+//     ширине, умноженной на длину сечения посередине. O(e * a log a), где e - число событий,
+//     a - число фигур компоненты, пересекающих полосу.
+// Для разреженных наборов время O(n log n + k), k - число пересекающихся пар. Фигуры
+// считаются выпуклыми и замкнутыми; фигуры с нечисловыми координатами пропускаются.
+// Результат не зависит от числа потоков.
+
+namespace union_area_detail {
+
+// Осевой прямоугольник: каждое ребро параллельно одной из осей
+inline bool isAxisAligned(const CollisionShape& shape) {
+    if (shape.count != 4) return false;
+    for (size_t v = 0; v < 4; ++v) {
+        size_t next = (v + 1) % 4;
+        if (shape.xs[v] != shape.xs[next] && shape.ys[v] != shape.ys[next]) return false;
+    }
+    return true;
+}
+
+// Площадь многоугольника по формуле шнурования
+inline double shapeArea(const CollisionShape& shape) {
+    double twice = 0.0;
+    for (size_t v = 0; v < shape.count; ++v) {
+        size_t next = v + 1 == shape.count ? 0 : v + 1;
+        twice += shape.xs[v] * shape.ys[next] - shape.xs[next] * shape.ys[v];
+    }
+    return std::abs(twice) / 2;
+}
+
+// Дерево отрезков над элементарными интервалами [ys[i], ys[i + 1]]
+class CoverTree {
+private:
+    const std::vector<double>& _ys;
+    std::vector<int> _cover;
+    std::vector<double> _length;
+
+    void update(size_t node, size_t left, size_t right, size_t first, size_t last, int delta) {
+        if (last <= left || right <= first) return;
+        if (first <= left && right <= last) {
+            _cover[node] += delta;
+        } else {
+            size_t middle = (left + right) / 2;
+            update(2 * node, left, middle, first, last, delta);
+            update(2 * node + 1, middle, right, first, last, delta);
+        }
+        if (_cover[node] > 0) {
+            _length[node] = _ys[right] - _ys[left];
+        } else if (right - left == 1) {
+            _length[node] = 0.0;
+        } else {
+            _length[node] = _length[2 * node] + _length[2 * node + 1];
+        }
+    }
+
+public:
+    explicit CoverTree(const std::vector<double>& ys)
+        : _ys(ys), _cover(4 * ys.size(), 0), _length(4 * ys.size(), 0.0) {}
+
+    // Изменение покрытия интервала [ys[first], ys[last]]
+    void add(size_t first, size_t last, int delta) {
+        if (first < last) update(1, 0, _ys.size() - 1, first, last, delta);
+    }
+
+    double coveredLength() const { return _length[1]; }
+};
+
+// Объединение осевых прямоугольников
+inline double axisAlignedUnion(const std::vector<CollisionShape>& shapes, const size_t* members, size_t count) {
+    struct Event {
+        double x;
+        size_t first;
+        size_t last;
+        int delta;
+    };
+
+    std::vector<double> ys;
+    ys.reserve(2 * count);
+    for (size_t m = 0; m < count; ++m) {
+        ys.push_back(shapes[members[m]].minY);
+        ys.push_back(shapes[members[m]].maxY);
+    }
+    std::sort(ys.begin(), ys.end());
+    ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+    if (ys.size() < 2) return 0.0;
+
+    auto rank = [&](double y) { return static_cast<size_t>(std::lower_bound(ys.begin(), ys.end(), y) - ys.begin()); };
+    std::vector<Event> events;
+    events.reserve(2 * count);
+    for (size_t m = 0; m < count; ++m) {
+        const CollisionShape& shape = shapes[members[m]];
+        size_t first = rank(shape.minY);
+        size_t last = rank(shape.maxY);
+        events.push_back({shape.minX, first, last, 1});
+        events.push_back({shape.maxX, first, last, -1});
+    }
+    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.x < b.x; });
+
+    CoverTree tree(ys);
+    KahanSum area;
+    for (size_t e = 0; e < events.size(); ++e) {
+        if (e > 0) area.add(tree.coveredLength() * (events[e].x - events[e - 1].x));
+        tree.add(events[e].first, events[e].last, events[e].delta);
+    }
+    return area.result();
+}
+
+// Если ребро v фигуры first пересекает ребро u фигуры second, добавляет x точки пересечения
+inline void addCrossing(const CollisionShape& first, size_t v, const CollisionShape& second, size_t u,
+                        std::vector<double>& xs) {
+    size_t vNext = v + 1 == first.count ? 0 : v + 1;
+    size_t uNext = u + 1 == second.count ? 0 : u + 1;
+    double rx = first.xs[vNext] - first.xs[v];
+    double ry = first.ys[vNext] - first.ys[v];
+    double sx = second.xs[uNext] - second.xs[u];
+    double sy = second.ys[uNext] - second.ys[u];
+    double denominator = rx * sy - ry * sx;
+    if (denominator == 0) return;  // Параллельные рёбра не меняют порядок
+    double qx = second.xs[u] - first.xs[v];
+    double qy = second.ys[u] - first.ys[v];
+    double t = (qx * sy - qy * sx) / denominator;
+    double w = (qx * ry - qy * rx) / denominator;
+    if (t < 0 || t > 1 || w < 0 || w > 1) return;
+    xs.push_back(first.xs[v] + t * rx);
+}
+
+// Сечение выпуклой фигуры вертикалью x: [low, high]; x лежит строго внутри X-диапазона фигуры
+inline std::pair<double, double> section(const CollisionShape& shape, double x) {
+    double low = std::numeric_limits<double>::infinity();
+    double high = -std::numeric_limits<double>::infinity();
+    for (size_t v = 0; v < shape.count; ++v) {
+        size_t next = v + 1 == shape.count ? 0 : v + 1;
+        double x0 = shape.xs[v], x1 = shape.xs[next];
+        if ((x0 < x && x < x1) || (x1 < x && x < x0)) {
+            double y = shape.ys[v] + (shape.ys[next] - shape.ys[v]) * (x - x0) / (x1 - x0);
+            low = std::min(low, y);
+            high = std::max(high, y);
+        }
+    }
+    return {low, high};
+}
+
+// Объединение произвольных выпуклых фигур; pairs - пересекающиеся пары компоненты
+inline double polygonUnion(const std::vector<CollisionShape>& shapes, const size_t* members, size_t count,
+                           const std::pair<size_t, size_t>* pairs, size_t pairCount) {
+    std::vector<double> xs;
+    for (size_t m = 0; m < count; ++m) {
+        const CollisionShape& shape = shapes[members[m]];
+        xs.insert(xs.end(), shape.xs, shape.xs + shape.count);
+    }
+    for (size_t p = 0; p < pairCount; ++p) {
+        const CollisionShape& first = shapes[pairs[p].first];
+        const CollisionShape& second = shapes[pairs[p].second];
+        for (size_t v = 0; v < first.count; ++v) {
+            for (size_t u = 0; u < second.count; ++u) addCrossing(first, v, second, u, xs);
+        }
+    }
+    std::sort(xs.begin(), xs.end());
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+
+    // Фигуры в порядке minX; активные - те, чей X-диапазон накрывает текущую полосу
+    std::vector<size_t> order(members, members + count);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return shapes[a].minX < shapes[b].minX; });
+    std::vector<size_t> active;
+    std::vector<std::pair<double, double>> sections;
+    size_t next = 0;
+    KahanSum area;
+    for (size_t e = 0; e + 1 < xs.size(); ++e) {
+        double left = xs[e];
+        double right = xs[e + 1];
+        while (next < order.size() && shapes[order[next]].minX <= left) active.push_back(order[next++]);
+        std::erase_if(active, [&](size_t index) { return shapes[index].maxX <= left; });
+
+        double middle = left + (right - left) / 2;
+        sections.clear();
+        for (size_t index : active) sections.push_back(section(shapes[index], middle));
+        std::sort(sections.begin(), sections.end());
+
+        double length = 0.0;
+        double coveredTo = -std::numeric_limits<double>::infinity();
+        for (const auto& [low, high] : sections) {
+            if (high <= coveredTo) continue;
+            length += high - std::max(low, coveredTo);
+            coveredTo = high;
+        }
+        area.add(length * (right - left));
+    }
+    return area.result();
+}
+
+// Корень множества с сокращением пути (корень - наименьший индекс множества)
+inline size_t findRoot(std::vector<size_t>& parent, size_t index) {
+    while (parent[index] != index) {
+        parent[index] = parent[parent[index]];
+        index = parent[index];
+    }
+    return index;
+}
+
+} // namespace union_area_detail
+
+// Площадь объединения фигур контейнера с size() и operator[] (FigureArray, StaticFigureArray)
+template <typename Array>
+double computeUnionArea(const Array& array, ThreadPool& pool = defaultThreadPool()) {
+    using namespace union_area_detail;
+    std::vector<CollisionShape> shapes = collision_detail::buildShapes(array, pool);
+    std::vector<std::pair<size_t, size_t>> pairs = collision_detail::intersectingPairs(shapes, pool);
+    size_t count = shapes.size();
+
+    std::vector<size_t> parent(count);
+    for (size_t i = 0; i < count; ++i) parent[i] = i;
+    for (const auto& [first, second] : pairs) {
+        size_t a = findRoot(parent, first);
+        size_t b = findRoot(parent, second);
+        if (a != b) parent[std::max(a, b)] = std::min(a, b);
+    }
+
+    // Номера компонент в порядке наименьшего индекса, затем члены и пары по компонентам (сортировка подсчётом)
+    std::vector<size_t> component(count, 0);
+    size_t components = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (!collision_detail::isFinite(shapes[i])) continue;
+        size_t root = findRoot(parent, i);
+        component[i] = root == i ? components++ : component[root];
+    }
+    std::vector<size_t> memberStart(components + 1, 0);
+    std::vector<size_t> pairStart(components + 1, 0);
+    for (size_t i = 0; i < count; ++i) {
+        if (collision_detail::isFinite(shapes[i])) ++memberStart[component[i] + 1];
+    }
+    for (const auto& pair : pairs) ++pairStart[component[pair.first] + 1];
+    for (size_t c = 0; c < components; ++c) {
+        memberStart[c + 1] += memberStart[c];
+        pairStart[c + 1] += pairStart[c];
+    }
+    std::vector<size_t> members(memberStart[components]);
+    std::vector<std::pair<size_t, size_t>> grouped(pairs.size());
+    {
+        std::vector<size_t> fill(memberStart.begin(), memberStart.end() - 1);
+        for (size_t i = 0; i < count; ++i) {
+            if (collision_detail::isFinite(shapes[i])) members[fill[component[i]]++] = i;
+        }
+        fill.assign(pairStart.begin(), pairStart.end() - 1);
+        for (const auto& pair : pairs) grouped[fill[component[pair.first]]++] = pair;
+    }
+
+    constexpr size_t componentsPerChunk = 1024;
+    std::vector<double> areas(components);
+    pool.parallelFor((components + componentsPerChunk - 1) / componentsPerChunk, [&](size_t chunk) {
+        size_t end = std::min(components, (chunk + 1) * componentsPerChunk);
+        for (size_t c = chunk * componentsPerChunk; c < end; ++c) {
+            const size_t* first = members.data() + memberStart[c];
+            size_t size = memberStart[c + 1] - memberStart[c];
+            if (size == 1) {
+                areas[c] = shapeArea(shapes[*first]);
+            } else if (std::all_of(first, first + size, [&](size_t i) { return isAxisAligned(shapes[i]); })) {
+                areas[c] = axisAlignedUnion(shapes, first, size);
+            } else {
+                areas[c] = polygonUnion(shapes, first, size, grouped.data() + pairStart[c], pairStart[c + 1] - pairStart[c]);
+            }
+        }
+    });
+    return pairwiseSum(areas.data(), areas.size());
+}
+
+#endif
@@ -1,12 +1,53 @@
 #include <gtest/gtest.h>
 #include <sstream>
 #include <memory>
+#include <new>
+#include <cstdlib>
+#include <atomic>
+#include <memory_resource>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <map>
+#include <limits>
 #include "../include/figure.h"
 #include "../include/square.h"
 #include "../include/rectangle.h"
 #include "../include/triangle.h"
 #include "../include/array.h"
 #include "../include/points.h"
+#include "../include/column_store.h"
+#include "../include/batch_area.h"
+#include "../include/batch_validity.h"
+#include "../include/static_array.h"
+#include "../include/spatial_index.h"
+#include "../include/binary_io.h"
+#include "../include/mapped_view.h"
+#include "../include/text_loader.h"
+#include "../include/report_writer.h"
+#include "../include/exact.h"
+#include "../include/geometry.h"
+#include "../include/concurrent_array.h"
+#include "../include/statistics.h"
+#include "../include/collision.h"
+#include "../include/union_area.h"
+
+// Подсчёт выделений памяти через глобальный operator new
+static std::atomic<size_t> allocationCount{0};
+
+void* operator new(size_t size) {
+    ++allocationCount;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
  
 // Тесты для класса Point
 TEST(PointTest, ParameterConstructor) {
@@ -165,6 +206,39 @@ TEST(TriangleFloatTest, InvalidTriangle) {
     EXPECT_FALSE(invalidTriangle.checkValidity());
 }
 
+// Тесты на отсутствие выделений памяти при работе с фигурами
+TEST(FigureAllocationTest, BuildCopyDestroyAllocatesNothing) {
+    size_t before = allocationCount.load();
+    {
+        Triangle<int> t(Point<int>(0, 0), Point<int>(3, 0), Point<int>(0, 4));
+        Square<float> s(
+            Point<float>(0.0f, 0.0f), Point<float>(1.0f, 0.0f),
+            Point<float>(1.0f, 1.0f), Point<float>(0.0f, 1.0f));
+        Rectangle<double> r;
+
+        Triangle<int> tCopy(t);
+        Square<float> sCopy(s);
+        Rectangle<double> rCopy(r);
+        tCopy = t;
+        sCopy = s;
+        rCopy = std::move(r);
+
+        EXPECT_TRUE(tCopy == t);
+        EXPECT_TRUE(sCopy.checkValidity());
+    }
+    EXPECT_EQ(allocationCount.load() - before, 0);
+}
+
+TEST(FigureAllocationTest, MakeSharedAllocatesOnce) {
+    size_t before = allocationCount.load();
+    {
+        auto square = std::make_shared<Square<int>>(
+            Point<int>(0, 0), Point<int>(2, 0), Point<int>(2, 2), Point<int>(0, 2));
+        EXPECT_NEAR(static_cast<double>(*square), 4.0, 0.001);
+    }
+    EXPECT_EQ(allocationCount.load() - before, 1);
+}
+
 // Тесты для класса FigureArray
 TEST(FigureArrayTest, DefaultConstructor) {
     FigureArray<int> array;
@@ -304,6 +378,2039 @@ TEST(FigureArrayFloatTest, MixedFigures) {
     EXPECT_NEAR(totalArea, 20.0, 0.001);
 }
 
+// Тесты для класса FigureColumnStore
+TEST(FigureColumnStoreTest, RoundTripFromFigureArray) {
+    FigureArray<int> array;
+    array.add(std::make_shared<Square<int>>(
+        Point<int>(0, 0), Point<int>(2, 0), Point<int>(2, 2), Point<int>(0, 2)));
+    array.add(std::make_shared<Triangle<int>>(
+        Point<int>(0, 0), Point<int>(3, 0), Point<int>(0, 4)));
+    array.add(std::make_shared<Rectangle<int>>(
+        Point<int>(0, 0), Point<int>(4, 0), Point<int>(4, 2), Point<int>(0, 2)));
+
+    FigureColumnStore<int> store(array);
+    EXPECT_EQ(store.size(), 3);
+    EXPECT_EQ(store.totalVertices(), 11);
+    EXPECT_EQ(store.kind(1), FigureKind::Triangle);
+    EXPECT_EQ(store.vertexCount(1), 3);
+    EXPECT_EQ(store.getVertex(2, 1), Point<int>(4, 0));
+
+    FigureArray<int> restored = store.toFigureArray();
+    ASSERT_EQ(restored.size(), array.size());
+    for (size_t i = 0; i < array.size(); ++i) {
+        EXPECT_TRUE(restored[i] == array[i]);
+    }
+}
+
+TEST(FigureColumnStoreTest, MatchesPerObjectGeometry) {
+    FigureArray<float> array;
+    array.add(std::make_shared<Square<float>>(
+        Point<float>(1.0f, 1.0f), Point<float>(3.5f, 1.0f), Point<float>(3.5f, 3.5f), Point<float>(1.0f, 3.5f)));
+    array.add(std::make_shared<Rectangle<float>>(
+        Point<float>(0.0f, 0.0f), Point<float>(4.5f, 0.0f), Point<float>(4.5f, 2.5f), Point<float>(0.0f, 2.5f)));
+    array.add(std::make_shared<Triangle<float>>(
+        Point<float>(0.0f, 0.0f), Point<float>(3.5f, 0.0f), Point<float>(0.0f, 4.2f)));
+    array.add(std::make_shared<Triangle<float>>(
+        Point<float>(0.0f, 0.0f), Point<float>(1.1f, 1.1f), Point<float>(2.2f, 2.2f)));
+
+    FigureColumnStore<float> store(array);
+    for (size_t i = 0; i < array.size(); ++i) {
+        EXPECT_NEAR(store.calculateArea(i), array[i].calculateArea(), 1e-4);
+        EXPECT_EQ(store.getCentroid(i), array[i].getCentroid());
+        EXPECT_EQ(store.checkValidity(i), array[i].checkValidity());
+    }
+    EXPECT_NEAR(store.computeTotalArea(), array.computeTotalArea(), 1e-4);
+    EXPECT_EQ(store.countValid(), 3);
+}
+
+TEST(FigureColumnStoreTest, RejectsWrongVertexCount) {
+    FigureColumnStore<double> store;
+    Point<double> points[3] = {Point<double>(0, 0), Point<double>(1, 0), Point<double>(0, 1)};
+    EXPECT_THROW(store.add(FigureKind::Square, points, 3), std::invalid_argument);
+    EXPECT_THROW(store.kind(0), std::out_of_range);
+}
+
+// Тесты для пакетного вычисления площадей
+TEST(BatchAreaTest, MatchesPerObjectAreaOnEveryLevel) {
+    FigureArray<double> array;
+    for (int i = 0; i < 37; ++i) {
+        double s = 1.0 + i * 0.25;
+        double ox = i * 3.0 - 50.0;
+        double oy = 10.0 - i * 1.5;
+        array.add(std::make_shared<Triangle<double>>(
+            Point<double>(ox, oy), Point<double>(ox + s, oy + 0.5), Point<double>(ox + 0.3, oy + 2 * s)));
+        // Квадрат, повёрнутый на произвольный угол
+        array.add(std::make_shared<Square<double>>(
+            Point<double>(ox, oy), Point<double>(ox + s, oy + 0.5 * s),
+            Point<double>(ox + 0.5 * s, oy + 1.5 * s), Point<double>(ox - 0.5 * s, oy + s)));
+        array.add(std::make_shared<Rectangle<double>>(
+            Point<double>(ox, oy), Point<double>(ox + 2 * s, oy),
+            Point<double>(ox + 2 * s, oy + s), Point<double>(ox, oy + s)));
+    }
+
+    FigureColumnStore<double> store(array);
+    std::vector<double> reference;
+    computeAreasBatch(store, reference, SimdLevel::Scalar);
+    for (size_t i = 0; i < array.size(); ++i) {
+        EXPECT_NEAR(reference[i], array[i].calculateArea(), 1e-9);
+    }
+
+    for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        std::vector<double> areas;
+        computeAreasBatch(store, areas, level);
+        ASSERT_EQ(areas.size(), reference.size());
+        for (size_t i = 0; i < areas.size(); ++i) {
+            EXPECT_EQ(areas[i], reference[i]) << simdLevelName(level) << " at " << i;
+        }
+    }
+}
+
+TEST(BatchAreaTest, FloatKernelMatchesPerObjectArea) {
+    FigureArray<float> array;
+    for (int i = 0; i < 35; ++i) {
+        float s = 1.0f + i * 0.5f;
+        array.add(std::make_shared<Triangle<float>>(
+            Point<float>(0.0f, 0.0f), Point<float>(s, 0.0f), Point<float>(0.0f, s + 1.0f)));
+        array.add(std::make_shared<Square<float>>(
+            Point<float>(1.0f, 1.0f), Point<float>(1.0f + s, 1.0f),
+            Point<float>(1.0f + s, 1.0f + s), Point<float>(1.0f, 1.0f + s)));
+    }
+
+    FigureColumnStore<float> store(array);
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        std::vector<double> areas;
+        computeAreasBatch(store, areas, level);
+        for (size_t i = 0; i < array.size(); ++i) {
+            EXPECT_NEAR(areas[i], array[i].calculateArea(), 1e-3) << simdLevelName(level);
+        }
+    }
+}
+
+TEST(BatchAreaTest, RejectsDegenerateVertexCount) {
+    double xs[2] = {0.0, 1.0};
+    double area = 0.0;
+    EXPECT_THROW(batchShoelaceArea(xs, xs, 2, 1, &area), std::invalid_argument);
+}
+
+// Тесты для пакетной проверки валидности
+static FigureColumnStore<double> makeValidityStore() {
+    FigureColumnStore<double> store;
+    unsigned seed = 29;
+    auto next = [&seed](int range) {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<int>((seed >> 8) % static_cast<unsigned>(range));
+    };
+    for (int i = 0; i < 600; ++i) {
+        double ox = next(100);
+        double oy = next(100);
+        double a = 1 + next(5);
+        double b = next(4);
+        int variant = next(4);
+        // Поворот на вектор (a, b): квадрат и прямоугольник остаются правильными при variant == 0
+        double ax = a, ay = b;
+        double px = -b, py = a;
+        switch (i % 3) {
+            case 0: {
+                Point<double> p[3] = {Point<double>(ox, oy), Point<double>(ox + ax, oy + ay),
+                                      Point<double>(ox + (variant == 1 ? 2 * ax : px), oy + (variant == 1 ? 2 * ay : py))};
+                if (variant == 2) p[2] = p[0];
+                store.add(FigureKind::Triangle, p, 3);
+                break;
+            }
+            case 1: {
+                double skew = variant == 1 ? 1.0 : 0.0;
+                Point<double> p[4] = {Point<double>(ox, oy), Point<double>(ox + ax, oy + ay),
+                                      Point<double>(ox + ax + px + skew, oy + ay + py),
+                                      Point<double>(ox + px + skew, oy + py)};
+                if (variant == 2) p[3] = p[1];
+                store.add(FigureKind::Square, p, 4);
+                break;
+            }
+            default: {
+                double stretch = variant == 1 ? 2.0 : 3.0;
+                Point<double> p[4] = {Point<double>(ox, oy), Point<double>(ox + ax, oy + ay),
+                                      Point<double>(ox + ax + stretch * px, oy + ay + stretch * py),
+                                      Point<double>(ox + stretch * px + (variant == 3 ? 0.5 : 0.0), oy + stretch * py)};
+                store.add(FigureKind::Rectangle, p, 4);
+                break;
+            }
+        }
+    }
+    return store;
+}
+
+TEST(BatchValidityTest, MatchesCheckValidityOnEveryLevel) {
+    FigureColumnStore<double> store = makeValidityStore();
+    FigureArray<double> array = store.toFigureArray();
+
+    ValidityReport reference = checkValidityBatch(store, SimdLevel::Scalar);
+    ASSERT_EQ(reference.size(), store.size());
+    size_t valid = 0;
+    for (size_t i = 0; i < array.size(); ++i) {
+        EXPECT_EQ(reference.isValid(i), array[i].checkValidity()) << "figure " << i;
+        valid += array[i].checkValidity();
+    }
+    EXPECT_EQ(reference.validCount, valid);
+    EXPECT_GT(valid, 0u);
+    EXPECT_LT(valid, store.size());
+
+    for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        ValidityReport report = checkValidityBatch(store, level);
+        EXPECT_EQ(report.reasons, reference.reasons) << simdLevelName(level);
+        EXPECT_EQ(report.validMask, reference.validMask) << simdLevelName(level);
+    }
+}
+
+TEST(BatchValidityTest, LargeSidesMatchCheckValidity) {
+    // Стороны 1e4-1e6, различающиеся на 0, 3e-7 (равны в пределах EPS), 5e-6 и 3e-5
+    FigureColumnStore<double> store;
+    for (double side : {1e4, 1e5, 1e6}) {
+        for (double offset : {0.0, 12345.5, 1e6}) {
+            for (double delta : {0.0, 3e-7, 5e-6, 3e-5}) {
+                double o = offset;
+                Point<double> p[4] = {Point<double>(o, o), Point<double>(o + side, o),
+                                      Point<double>(o + side, o + side + delta), Point<double>(o, o + side + delta)};
+                store.add(FigureKind::Square, p, 4);
+                Point<double> q[4] = {Point<double>(o, o), Point<double>(o + 2 * side, o),
+                                      Point<double>(o + 2 * side + delta, o + side), Point<double>(o, o + side)};
+                store.add(FigureKind::Rectangle, q, 4);
+            }
+        }
+    }
+    FigureArray<double> array = store.toFigureArray();
+
+    size_t valid = 0;
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+        ValidityReport report = checkValidityBatch(store, level);
+        valid = 0;
+        for (size_t i = 0; i < array.size(); ++i) {
+            EXPECT_EQ(report.isValid(i), array[i].checkValidity()) << simdLevelName(level) << " figure " << i;
+            valid += array[i].checkValidity();
+        }
+    }
+    // Валидны фигуры с разницей сторон 0 и 3e-7
+    EXPECT_EQ(valid, 3u * 3u * 2u * 2u);
+}
+
+TEST(BatchValidityTest, ReportsReasons) {
+    FigureColumnStore<double> store;
+    Point<double> duplicate[3] = {Point<double>(0, 0), Point<double>(0, 0), Point<double>(1, 1)};
+    Point<double> collinear[3] = {Point<double>(0, 0), Point<double>(1, 1), Point<double>(2, 2)};
+    Point<double> rhombus[4] = {Point<double>(0, 0), Point<double>(2, 0), Point<double>(3, 2), Point<double>(1, 2)};
+    Point<double> rectangle[4] = {Point<double>(0, 0), Point<double>(3, 0), Point<double>(3, 1), Point<double>(0, 1)};
+    Point<double> squareLike[4] = {Point<double>(0, 0), Point<double>(3, 0), Point<double>(3, 1), Point<double>(0, 1)};
+    store.add(FigureKind::Triangle, duplicate, 3);
+    store.add(FigureKind::Triangle, collinear, 3);
+    store.add(FigureKind::Rectangle, rhombus, 4);
+    store.add(FigureKind::Rectangle, rectangle, 4);
+    store.add(FigureKind::Square, squareLike, 4);
+
+    ValidityReport report = checkValidityBatch(store);
+    EXPECT_EQ(report.reasons[0], ValidityReason::DuplicateVertex);
+    EXPECT_EQ(report.reasons[1], ValidityReason::Degenerate);
+    EXPECT_EQ(report.reasons[2], ValidityReason::NotRightAngle);
+    EXPECT_EQ(report.reasons[3], ValidityReason::Valid);
+    EXPECT_EQ(report.reasons[4], ValidityReason::UnequalSides);
+    EXPECT_EQ(report.validMask, std::vector<uint64_t>{uint64_t(1) << 3});
+    EXPECT_STREQ(validityReasonName(report.reasons[2]), "not a right angle");
+}
+
+TEST(BatchValidityTest, IntegralCoordinatesUseExactPredicates) {
+    // Удвоенная площадь 1 при координатах порядка 2^40: в double произведения округляются до равных
+    const int64_t a = int64_t(1) << 40;
+    Point<int64_t> thin[3] = {Point<int64_t>(0, 0), Point<int64_t>(a, a - 1), Point<int64_t>(a + 1, a)};
+    Point<int64_t> collinear[3] = {Point<int64_t>(0, 0), Point<int64_t>(a, a), Point<int64_t>(a + 1, a + 1)};
+    FigureColumnStore<int64_t> store;
+    store.add(FigureKind::Triangle, thin, 3);
+    store.add(FigureKind::Triangle, collinear, 3);
+
+    ValidityReport report = checkValidityBatch(store);
+    EXPECT_EQ(report.reasons[0], ValidityReason::Valid);
+    EXPECT_EQ(report.reasons[1], ValidityReason::Degenerate);
+    EXPECT_TRUE(store.checkValidity(0));
+    EXPECT_FALSE(store.checkValidity(1));
+    EXPECT_TRUE(Triangle<int64_t>(thin[0], thin[1], thin[2]).checkValidity());
+}
+
+// Тесты для параллельных агрегатов FigureArray
+TEST(FigureArrayParallelTest, TotalAreaDoesNotDependOnThreadCount) {
+    FigureArray<double> array;
+    for (int i = 0; i < 20000; ++i) {
+        double s = 0.1 + (i % 97) * 0.37;
+        if (i % 2 == 0) {
+            array.add(std::make_shared<Square<double>>(
+                Point<double>(0, 0), Point<double>(s, 0), Point<double>(s, s), Point<double>(0, s)));
+        } else {
+            array.add(std::make_shared<Triangle<double>>(
+                Point<double>(0, 0), Point<double>(s, 0), Point<double>(0, 1e-3 * i)));
+        }
+    }
+
+    double serial = array.computeTotalArea();
+    ThreadPool single(1);
+    double reference = array.computeTotalAreaParallel(single);
+    EXPECT_NEAR(reference, serial, 1e-6 * serial);
+
+    for (size_t threads : {2, 3, 8}) {
+        ThreadPool pool(threads);
+        EXPECT_EQ(pool.threadCount(), threads);
+        EXPECT_EQ(array.computeTotalAreaParallel(pool), reference);
+    }
+}
+
+TEST(FigureArrayParallelTest, AreasAndCentroidsMatchSerial) {
+    FigureArray<int> array;
+    for (int i = 0; i < 9000; ++i) {
+        array.add(std::make_shared<Rectangle<int>>(
+            Point<int>(i, 0), Point<int>(i + 4, 0), Point<int>(i + 4, 2), Point<int>(i, 2)));
+    }
+
+    ThreadPool pool(4);
+    std::vector<double> areas = array.computeAreasParallel(pool);
+    std::vector<Point<int>> centroids = array.computeCentroidsParallel(pool);
+    ASSERT_EQ(areas.size(), array.size());
+    ASSERT_EQ(centroids.size(), array.size());
+    for (size_t i = 0; i < array.size(); ++i) {
+        EXPECT_EQ(areas[i], static_cast<double>(array[i]));
+        EXPECT_EQ(centroids[i], array[i].getCentroid());
+    }
+}
+
+TEST(ThreadPoolTest, PropagatesTaskException) {
+    ThreadPool pool(3);
+    EXPECT_THROW(pool.parallelFor(16, [](size_t chunk) {
+        if (chunk == 7) throw std::runtime_error("chunk failed");
+    }), std::runtime_error);
+
+    std::atomic<size_t> visited{0};
+    pool.parallelFor(100, [&](size_t) { ++visited; });
+    EXPECT_EQ(visited.load(), 100);
+}
+
+// Тесты для класса ConcurrentFigureArray
+TEST(ConcurrentFigureArrayTest, KeepsOrderAcrossSegments) {
+    ConcurrentFigureArray<int> array;
+    EXPECT_EQ(array.size(), 0u);
+    EXPECT_THROW(array[0], std::out_of_range);
+
+    for (int i = 0; i < 5000; ++i) {
+        size_t index = array.add(std::make_shared<Rectangle<int>>(
+            Point<int>(0, 0), Point<int>(i + 1, 0), Point<int>(i + 1, 1), Point<int>(0, 1)));
+        EXPECT_EQ(index, static_cast<size_t>(i));
+    }
+    ASSERT_EQ(array.size(), 5000u);
+    EXPECT_EQ(array[1023].calculateArea(), 1024.0);
+    EXPECT_EQ(array[1024].calculateArea(), 1025.0);
+    EXPECT_EQ(array[4999].calculateArea(), 5000.0);
+    EXPECT_EQ(array.computeTotalArea(), 5000.0 * 5001 / 2);
+
+    ThreadPool pool(3);
+    EXPECT_EQ(array.computeTotalAreaParallel(pool), 5000.0 * 5001 / 2);
+
+    FigureArray<int> target;
+    EXPECT_EQ(array.appendTo(target), 5000u);
+    ASSERT_EQ(target.size(), 5000u);
+    EXPECT_EQ(&target[77], &array[77]);
+}
+
+TEST(ConcurrentFigureArrayTest, ReadersSeeConsistentPrefix) {
+    ConcurrentFigureArray<int> array;
+    const size_t writers = 4;
+    const size_t perWriter = 20000;
+    std::atomic<bool> done{false};
+
+    // Все квадраты единичные: сумма площадей снимка равна его длине
+    std::atomic<size_t> badSnapshots{0};
+    std::thread reader([&] {
+        while (!done.load()) {
+            double total = 0.0;
+            size_t count = array.forEach([&](size_t, const Figure<int>& figure) { total += figure.calculateArea(); });
+            if (total != static_cast<double>(count)) ++badSnapshots;
+        }
+    });
+
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < writers; ++w) {
+        threads.emplace_back([&] {
+            for (size_t i = 0; i < perWriter; ++i) {
+                array.emplace<Square<int>>();
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(badSnapshots.load(), 0u);
+    ASSERT_EQ(array.size(), writers * perWriter);
+    EXPECT_EQ(array.computeTotalArea(), static_cast<double>(writers * perWriter));
+}
+
+// Тесты для статистики площадей по видам фигур
+TEST(StatisticsTest, MatchesBruteForcePerKind) {
+    FigureArray<double> array;
+    for (int i = 0; i < 30000; ++i) {
+        double s = 0.5 + (i * 7919 % 1000) * 0.05;
+        switch (i % 3) {
+            case 0:
+                array.emplace<Triangle<double>>(Point<double>(0, 0), Point<double>(s, 0), Point<double>(0, 2));
+                break;
+            case 1:
+                array.emplace<Square<double>>(Point<double>(0, 0), Point<double>(s, 0), Point<double>(s, s), Point<double>(0, s));
+                break;
+            default:
+                if (i % 5 == 0) {
+                    array.emplace<Rectangle<double>>(Point<double>(1, 1), Point<double>(1, 1), Point<double>(1, 1), Point<double>(1, 1));
+                } else {
+                    array.emplace<Rectangle<double>>(Point<double>(0, 0), Point<double>(s, 0), Point<double>(s, 3), Point<double>(0, 3));
+                }
+                break;
+        }
+    }
+
+    StatisticsOptions options;
+    options.histogramEdges = {1, 10, 100};
+    ThreadPool pool(4);
+    FigureStatistics stats = computeFigureStatistics(array, options, pool);
+
+    for (FigureKind kind : {FigureKind::Triangle, FigureKind::Square, FigureKind::Rectangle}) {
+        std::vector<double> areas;
+        std::vector<size_t> histogram(4, 0);
+        for (size_t i = 0; i < array.size(); ++i) {
+            if (array[i].kind() != kind) continue;
+            double area = array[i].calculateArea();
+            areas.push_back(area);
+            ++histogram[area < 1 ? 0 : area < 10 ? 1 : area < 100 ? 2 : 3];
+        }
+        std::sort(areas.begin(), areas.end());
+        const AreaStatistics& group = stats.of(kind);
+        ASSERT_EQ(group.count, areas.size());
+        EXPECT_EQ(group.min, areas.front());
+        EXPECT_EQ(group.max, areas.back());
+        double sum = 0.0;
+        for (double area : areas) sum += area;
+        EXPECT_NEAR(group.sum, sum, 1e-9 * sum);
+        EXPECT_NEAR(group.mean(), sum / areas.size(), 1e-9 * sum);
+        EXPECT_EQ(group.histogram, histogram);
+
+        for (double q : {0.0, 0.1, 0.5, 0.9, 0.99, 1.0}) {
+            double exact = areas[static_cast<size_t>(q * (areas.size() - 1))];
+            EXPECT_NEAR(group.quantile(q), exact, 0.01 * exact + 1e-12) << "q = " << q;
+        }
+    }
+    EXPECT_EQ(stats.all.count, array.size());
+    EXPECT_EQ(stats.of(FigureKind::Rectangle).min, 0.0);
+}
+
+TEST(StatisticsTest, ResultDoesNotDependOnThreadCount) {
+    FigureArray<float> array;
+    for (int i = 0; i < 50000; ++i) {
+        float s = 0.1f + static_cast<float>(i % 313) * 0.37f;
+        array.emplace<Square<float>>(Point<float>(0, 0), Point<float>(s, 0), Point<float>(s, s), Point<float>(0, s));
+    }
+    ThreadPool single(1);
+    ThreadPool many(5);
+    FigureStatistics a = computeFigureStatistics(array, StatisticsOptions(), single);
+    FigureStatistics b = computeFigureStatistics(array, StatisticsOptions(), many);
+    EXPECT_EQ(a.all.sum, b.all.sum);
+    EXPECT_EQ(a.all.quantile(0.5), b.all.quantile(0.5));
+    EXPECT_TRUE(a.all.histogram.empty());
+    EXPECT_EQ(a.of(FigureKind::Triangle).count, 0u);
+    EXPECT_TRUE(std::isnan(a.of(FigureKind::Triangle).mean()));
+}
+
+// Тесты для класса StaticFigureArray
+TEST(StaticFigureArrayTest, MatchesFigureArray) {
+    FigureArray<float> dynamicArray;
+    StaticFigureArray<float> staticArray;
+
+    auto square = std::make_shared<Square<float>>(
+        Point<float>(1.0f, 1.0f), Point<float>(3.0f, 1.0f), Point<float>(3.0f, 3.0f), Point<float>(1.0f, 3.0f));
+    auto rectangle = std::make_shared<Rectangle<float>>(
+        Point<float>(0.0f, 0.0f), Point<float>(5.0f, 0.0f), Point<float>(5.0f, 2.0f), Point<float>(0.0f, 2.0f));
+    auto triangle = std::make_shared<Triangle<float>>(
+        Point<float>(0.0f, 0.0f), Point<float>(4.0f, 0.0f), Point<float>(0.0f, 3.0f));
+
+    for (const auto& figure : {std::shared_ptr<Figure<float>>(square), std::shared_ptr<Figure<float>>(rectangle),
+                               std::shared_ptr<Figure<float>>(triangle)}) {
+        dynamicArray.add(figure);
+        staticArray.add(figure);
+    }
+    staticArray.add(Triangle<float>());
+
+    EXPECT_EQ(staticArray.size(), 4);
+    EXPECT_NEAR(staticArray.computeTotalArea(), dynamicArray.computeTotalArea() + 0.5, 0.001);
+    for (size_t i = 0; i < dynamicArray.size(); ++i) {
+        EXPECT_TRUE(staticArray[i] == dynamicArray[i]);
+        EXPECT_EQ(staticArray[i].getCentroid(), dynamicArray[i].getCentroid());
+    }
+    EXPECT_TRUE(std::holds_alternative<Rectangle<float>>(staticArray.variant(1)));
+
+    staticArray.erase(0);
+    EXPECT_EQ(staticArray.size(), 3);
+    EXPECT_EQ(staticArray[0].kind(), FigureKind::Rectangle);
+    EXPECT_THROW(staticArray.erase(3), std::out_of_range);
+}
+
+TEST(StaticFigureArrayTest, ParallelTotalAreaMatchesFigureArray) {
+    FigureArray<double> dynamicArray;
+    StaticFigureArray<double> staticArray;
+    for (int i = 0; i < 10000; ++i) {
+        double s = 0.5 + (i % 13);
+        auto figure = std::make_shared<Square<double>>(
+            Point<double>(0, 0), Point<double>(s, 0), Point<double>(s, s), Point<double>(0, s));
+        dynamicArray.add(figure);
+        staticArray.add(*figure);
+    }
+
+    ThreadPool pool(4);
+    EXPECT_EQ(staticArray.computeTotalAreaParallel(pool), dynamicArray.computeTotalAreaParallel(pool));
+    EXPECT_EQ(staticArray.computeAreasParallel(pool), dynamicArray.computeAreasParallel(pool));
+}
+
+TEST(StaticFigureArrayTest, SharedOperationsMatchFigureArray) {
+    FigureArray<double> dynamicArray;
+    StaticFigureArray<double> staticArray;
+    staticArray.reserve(400);
+    for (int i = 0; i < 400; ++i) {
+        // Фигуры повторяются с периодом 150
+        double x = (i % 150 * 37) % 101;
+        double s = 1 + (i % 150 * 13) % 7;
+        Point<double> a(x, -s), b(x + s, -s), c(x + s, 0), d(x, 0);
+        if (i % 3 == 0) {
+            dynamicArray.emplace<Triangle<double>>(a, b, d);
+            staticArray.emplace<Triangle<double>>(a, b, d);
+        } else if (i % 3 == 1) {
+            dynamicArray.emplace<Square<double>>(a, b, c, d);
+            staticArray.emplace<Square<double>>(a, b, c, d);
+        } else {
+            Point<double> e(x + 2 * s, -s), f(x + 2 * s, 0);
+            dynamicArray.emplace<Rectangle<double>>(a, e, f, d);
+            Rectangle<double>& added = staticArray.emplace<Rectangle<double>>(a, e, f, d);
+            EXPECT_EQ(&added, &staticArray[staticArray.size() - 1]);
+        }
+    }
+
+    FigureArrayStats<double> expected = dynamicArray.stats();
+    FigureArrayStats<double> actual = staticArray.stats();
+    EXPECT_EQ(actual.count, expected.count);
+    EXPECT_EQ(actual.kindCounts, expected.kindCounts);
+    EXPECT_NEAR(actual.totalArea, expected.totalArea, 1e-9);
+    EXPECT_EQ(actual.bounds.minX, expected.bounds.minX);
+    EXPECT_EQ(actual.bounds.minY, expected.bounds.minY);
+    EXPECT_EQ(actual.bounds.maxX, expected.bounds.maxX);
+    EXPECT_EQ(actual.bounds.maxY, expected.bounds.maxY);
+
+    EXPECT_EQ(staticArray.findDuplicates(), dynamicArray.findDuplicates());
+    EXPECT_FALSE(staticArray.findDuplicates().empty());
+
+    ThreadPool pool(3);
+    auto expectSameOrder = [&]() {
+        ASSERT_EQ(staticArray.size(), dynamicArray.size());
+        for (size_t i = 0; i < dynamicArray.size(); ++i) {
+            EXPECT_TRUE(staticArray[i] == dynamicArray[i]);
+        }
+    };
+    staticArray.sortBy(CentroidXKey(), SortOrder::Descending, pool);
+    dynamicArray.sortBy(CentroidXKey(), SortOrder::Descending, pool);
+    expectSameOrder();
+    staticArray.topK(25, AreaKey(), pool);
+    dynamicArray.topK(25, AreaKey(), pool);
+    expectSameOrder();
+    staticArray.nthElement(200, CentroidYKey(), SortOrder::Ascending, pool);
+    dynamicArray.nthElement(200, CentroidYKey(), SortOrder::Ascending, pool);
+    expectSameOrder();
+    EXPECT_THROW(staticArray.nthElement(400, AreaKey()), std::out_of_range);
+
+    EXPECT_EQ(staticArray.dedup(), dynamicArray.dedup());
+    expectSameOrder();
+    EXPECT_TRUE(staticArray.findDuplicates().empty());
+
+    staticArray.setCaching(true);
+    EXPECT_TRUE(staticArray[0].isCaching());
+    EXPECT_EQ(staticArray[0].area(), dynamicArray[0].area());
+    staticArray.setCaching(false);
+    EXPECT_FALSE(staticArray[0].isCaching());
+}
+
+// Тесты для размещения фигур в арене FigureArray
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t bytesInUse = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        bytesInUse += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        ++deallocations;
+        bytesInUse -= bytes;
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+TEST(FigureArrayArenaTest, EmplaceUsesFewUpstreamAllocations) {
+    CountingResource upstream;
+    {
+        FigureArray<int> array(&upstream);
+        for (int i = 0; i < 1000; ++i) {
+            Square<int>& square = array.emplace<Square<int>>(
+                Point<int>(i, 0), Point<int>(i + 2, 0), Point<int>(i + 2, 2), Point<int>(i, 2));
+            EXPECT_TRUE(square.checkValidity());
+        }
+        array.emplace<Triangle<int>>(Point<int>(0, 0), Point<int>(3, 0), Point<int>(0, 4));
+
+        EXPECT_EQ(array.size(), 1001);
+        EXPECT_NEAR(array.computeTotalArea(), 4006.0, 0.001);
+        EXPECT_LT(upstream.allocations, 20);
+
+        // Перемещение массива переносит и арену
+        FigureArray<int> moved(std::move(array));
+        EXPECT_EQ(moved[1000].kind(), FigureKind::Triangle);
+        moved.erase(0);
+        EXPECT_EQ(moved.size(), 1000);
+    }
+    EXPECT_EQ(upstream.allocations, upstream.deallocations);
+    EXPECT_EQ(upstream.bytesInUse, 0);
+}
+
+TEST(FigureArrayArenaTest, PoolArenaReusesErasedFigures) {
+    CountingResource upstream;
+    {
+        FigureArray<double> array(&upstream, ArenaPolicy::Pool);
+        for (int round = 0; round < 100; ++round) {
+            array.emplace<Rectangle<double>>();
+            array.emplace<Square<double>>();
+            array.erase(0);
+            array.erase(0);
+        }
+        EXPECT_EQ(array.size(), 0);
+        EXPECT_LT(upstream.allocations, 10);
+
+        // Обычные фигуры и фигуры из арены могут храниться вместе
+        array.add(std::make_shared<Triangle<double>>());
+        array.emplace<Triangle<double>>();
+        EXPECT_NEAR(array.computeTotalArea(), 1.0, 0.001);
+    }
+    EXPECT_EQ(upstream.bytesInUse, 0);
+}
+
+TEST(FigureArrayArenaTest, EraseEmplaceLoopStaysBounded) {
+    CountingResource upstream;
+    FigureArray<double> array(&upstream);
+    for (int i = 0; i < 64; ++i) array.emplace<Square<double>>();
+    auto churn = [&](int rounds) {
+        for (int round = 0; round < rounds; ++round) {
+            array.erase(0);
+            array.emplace<Triangle<double>>();
+            array.eraseUnordered(static_cast<size_t>(round) % array.size());
+            array.emplace<Rectangle<double>>();
+        }
+    };
+    churn(1000);
+    size_t allocations = upstream.allocations;
+    size_t bytesInUse = upstream.bytesInUse;
+    churn(100000);
+    EXPECT_EQ(array.size(), 64);
+    EXPECT_EQ(upstream.allocations, allocations);
+    EXPECT_EQ(upstream.bytesInUse, bytesInUse);
+
+    // Массив без ресурса не заводит арену
+    FigureArray<double> plain;
+    plain.emplace<Square<double>>();
+    plain.erase(0);
+    EXPECT_EQ(plain.size(), 0);
+}
+
+TEST(FigureArrayTest, AddAfterMoveReallocates) {
+    FigureArray<int> array;
+    array.add(std::make_shared<Square<int>>());
+    FigureArray<int> moved(std::move(array));
+    array.add(std::make_shared<Triangle<int>>());
+    EXPECT_EQ(array.size(), 1);
+    EXPECT_EQ(moved.size(), 1);
+}
+
+// Тесты для политик владения FigureArray
+template <typename Ownership>
+void checkOwnershipPolicy() {
+    FigureArray<double, Ownership> array;
+    for (int i = 0; i < 100; ++i) {
+        double s = 1 + i % 5;
+        if (i % 2 == 0) {
+            array.template emplace<Square<double>>(
+                Point<double>(0, 0), Point<double>(s, 0), Point<double>(s, s), Point<double>(0, s));
+        } else {
+            array.template emplace<Triangle<double>>(Point<double>(0, 0), Point<double>(s, 0), Point<double>(0, 2));
+        }
+    }
+    ASSERT_EQ(array.size(), 100u);
+    EXPECT_EQ(array[0].kind(), FigureKind::Square);
+    EXPECT_EQ(array[1].kind(), FigureKind::Triangle);
+
+    double total = 0.0;
+    for (size_t i = 0; i < array.size(); ++i) total += array[i].calculateArea();
+    EXPECT_EQ(array.computeTotalArea(), total);
+
+    array.erase(0);
+    array.eraseUnordered(10);
+    size_t removed = array.eraseIf([](const Figure<double>& f) { return f.kind() == FigureKind::Triangle; });
+    EXPECT_EQ(removed + array.size(), 98u);
+    for (size_t i = 0; i < array.size(); ++i) {
+        EXPECT_EQ(array[i].kind(), FigureKind::Square);
+        EXPECT_TRUE(array[i].checkValidity());
+    }
+
+    FigureArray<double, Ownership> moved(std::move(array));
+    EXPECT_EQ(moved.size(), 98u - removed);
+    EXPECT_EQ(FigureColumnStore<double>(moved).size(), moved.size());
+}
+
+TEST(OwnershipTest, AllPoliciesBehaveAlike) {
+    checkOwnershipPolicy<SharedOwnership>();
+    checkOwnershipPolicy<UniqueOwnership>();
+    checkOwnershipPolicy<IntrusiveOwnership>();
+    checkOwnershipPolicy<ValueOwnership>();
+}
+
+TEST(OwnershipTest, HandlesAddByPolicyType) {
+    FigureArray<int, UniqueOwnership> unique;
+    unique.add(std::make_unique<Square<int>>());
+    EXPECT_EQ(unique[0].calculateArea(), 1.0);
+
+    FigureArray<int, ValueOwnership> values;
+    values.add(Rectangle<int>());
+    Triangle<int> triangle;
+    values.add(static_cast<const Figure<int>&>(triangle));
+    EXPECT_EQ(values[0].kind(), FigureKind::Rectangle);
+    EXPECT_EQ(values[1], triangle);
+    EXPECT_NE(&values[1], &triangle);
+
+    // Интрузивный счётчик разделяется между массивами и не копируется вместе с фигурой
+    IntrusivePtr<Figure<int>> shared = makeIntrusive<Square<int>>();
+    FigureArray<int, IntrusiveOwnership> first;
+    FigureArray<int, IntrusiveOwnership> second;
+    first.add(shared);
+    second.add(shared);
+    EXPECT_EQ(shared.useCount(), 3u);
+    EXPECT_EQ(&first[0], &second[0]);
+    first.erase(0);
+    EXPECT_EQ(shared.useCount(), 2u);
+
+    IntrusivePtr<Figure<int>> copy = makeIntrusive<Square<int>>(static_cast<const Square<int>&>(*shared));
+    EXPECT_EQ(copy.useCount(), 1u);
+    EXPECT_EQ(*copy, *shared);
+}
+
+// Тесты для удаления без сдвига и пакетного удаления
+TEST(FigureArrayEraseTest, EraseUnorderedMovesLastIntoHole) {
+    FigureArray<int> array;
+    for (int i = 0; i < 5; ++i) {
+        array.add(std::make_shared<Square<int>>(
+            Point<int>(i, 0), Point<int>(i + 1, 0), Point<int>(i + 1, 1), Point<int>(i, 1)));
+    }
+
+    array.eraseUnordered(1);
+    ASSERT_EQ(array.size(), 4);
+    EXPECT_EQ(array[1].getVertex(0), Point<int>(4, 0));
+    EXPECT_EQ(array[3].getVertex(0), Point<int>(3, 0));
+
+    array.eraseUnordered(3);
+    EXPECT_EQ(array.size(), 3);
+    EXPECT_THROW(array.eraseUnordered(3), std::out_of_range);
+}
+
+TEST(FigureArrayEraseTest, EraseIfCompactsInOnePass) {
+    FigureArray<float> array;
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 3 == 0) {
+            // Вырожденный треугольник
+            array.add(std::make_shared<Triangle<float>>(
+                Point<float>(0.0f, 0.0f), Point<float>(1.0f, 1.0f), Point<float>(2.0f, 2.0f)));
+        } else {
+            float x = static_cast<float>(i);
+            array.add(std::make_shared<Triangle<float>>(
+                Point<float>(x, 0.0f), Point<float>(x + 3.0f, 0.0f), Point<float>(x, 4.0f)));
+        }
+    }
+
+    size_t removed = array.eraseIf([](const Figure<float>& figure) { return !figure.checkValidity(); });
+    EXPECT_EQ(removed, 334);
+    ASSERT_EQ(array.size(), 666);
+    EXPECT_NEAR(array.computeTotalArea(), 666 * 6.0, 0.01);
+
+    // Порядок оставшихся фигур сохраняется
+    EXPECT_EQ(array[0].getVertex(0), Point<float>(1.0f, 0.0f));
+    EXPECT_EQ(array[1].getVertex(0), Point<float>(2.0f, 0.0f));
+    EXPECT_EQ(array[2].getVertex(0), Point<float>(4.0f, 0.0f));
+}
+
+TEST(StaticFigureArrayTest, EraseUnorderedAndEraseIf) {
+    StaticFigureArray<int> array;
+    array.add(Square<int>());
+    array.add(Triangle<int>());
+    array.add(Rectangle<int>());
+    array.add(Triangle<int>());
+
+    array.eraseUnordered(0);
+    EXPECT_EQ(array[0].kind(), FigureKind::Triangle);
+    EXPECT_EQ(array.eraseIf([](const Figure<int>& f) { return f.kind() == FigureKind::Triangle; }), 2);
+    ASSERT_EQ(array.size(), 1);
+    EXPECT_EQ(array[0].kind(), FigureKind::Rectangle);
+}
+
+// Тесты для сводных показателей FigureArray
+template <typename Array>
+FigureArrayStats<int> bruteForceStats(const Array& array) {
+    FigureArrayStats<int> expected;
+    expected.count = array.size();
+    for (size_t i = 0; i < array.size(); ++i) {
+        expected.totalArea += array[i].calculateArea();
+        ++expected.kindCounts[static_cast<size_t>(array[i].kind())];
+        BoundingBox<int> box = array[i].boundingBox();
+        if (i == 0) expected.bounds = box;
+        else expected.bounds.expand(box);
+    }
+    return expected;
+}
+
+void expectStatsEqual(const FigureArrayStats<int>& actual, const FigureArrayStats<int>& expected) {
+    EXPECT_EQ(actual.count, expected.count);
+    EXPECT_EQ(actual.kindCounts, expected.kindCounts);
+    EXPECT_NEAR(actual.totalArea, expected.totalArea, 1e-9 * (1 + expected.totalArea));
+    EXPECT_EQ(actual.bounds.minX, expected.bounds.minX);
+    EXPECT_EQ(actual.bounds.minY, expected.bounds.minY);
+    EXPECT_EQ(actual.bounds.maxX, expected.bounds.maxX);
+    EXPECT_EQ(actual.bounds.maxY, expected.bounds.maxY);
+}
+
+TEST(FigureArrayStatsTest, TracksAddAndEraseIncrementally) {
+    FigureArray<int> array;
+    expectStatsEqual(array.stats(), FigureArrayStats<int>());
+
+    unsigned seed = 12345;
+    auto next = [&seed] { seed = seed * 1103515245u + 12345u; return (seed >> 8) % 1000; };
+    for (int step = 0; step < 3000; ++step) {
+        unsigned action = next() % 10;
+        if (action < 6 || array.size() == 0) {
+            int x = static_cast<int>(next()) - 500;
+            int y = static_cast<int>(next()) - 500;
+            int s = 1 + static_cast<int>(next() % 20);
+            switch (next() % 3) {
+                case 0:
+                    array.emplace<Triangle<int>>(Point<int>(x, y), Point<int>(x + s, y), Point<int>(x, y + s));
+                    break;
+                case 1:
+                    array.emplace<Square<int>>(Point<int>(x, y), Point<int>(x + s, y), Point<int>(x + s, y + s), Point<int>(x, y + s));
+                    break;
+                default:
+                    array.emplace<Rectangle<int>>(Point<int>(x, y), Point<int>(x + 2 * s, y), Point<int>(x + 2 * s, y + s), Point<int>(x, y + s));
+                    break;
+            }
+        } else if (action < 8) {
+            array.erase(next() % array.size());
+        } else if (action < 9) {
+            array.eraseUnordered(next() % array.size());
+        } else {
+            unsigned kind = next() % 3;
+            size_t position = 0;
+            array.eraseIf([&](const Figure<int>& f) {
+                return position++ % 7 == 0 && static_cast<unsigned>(f.kind()) == kind;
+            });
+        }
+        if (next() % 4 == 0) {
+            expectStatsEqual(array.stats(), bruteForceStats(array));
+        }
+    }
+    expectStatsEqual(array.stats(), bruteForceStats(array));
+
+    FigureArray<int> moved(std::move(array));
+    expectStatsEqual(moved.stats(), bruteForceStats(moved));
+    EXPECT_EQ(array.stats().count, 0u);
+
+    moved.eraseIf([](const Figure<int>&) { return true; });
+    expectStatsEqual(moved.stats(), FigureArrayStats<int>());
+}
+
+TEST(FigureArrayStatsTest, InvalidateAfterInPlaceEdit) {
+    FigureArray<int> array;
+    array.emplace<Square<int>>();
+    EXPECT_EQ(array.stats().totalArea, 1.0);
+
+    std::istringstream input("0 0 3 0 3 3 0 3");
+    array[0].input(input);
+    array.invalidateStats();
+    FigureArrayStats<int> stats = array.stats();
+    EXPECT_EQ(stats.totalArea, 9.0);
+    EXPECT_EQ(stats.countOf(FigureKind::Square), 1u);
+    EXPECT_EQ(stats.bounds.maxX, 3);
+}
+
+// Тесты для упорядочивания FigureArray
+FigureArray<int> makeOrderingArray(size_t count) {
+    FigureArray<int> array;
+    for (size_t i = 0; i < count; ++i) {
+        int s = 1 + static_cast<int>(i * 7919 % 211);
+        int x = static_cast<int>(i * 104729 % 1009);
+        if (i % 2 == 0) {
+            array.emplace<Square<int>>(Point<int>(x, 0), Point<int>(x + s, 0), Point<int>(x + s, s), Point<int>(x, s));
+        } else {
+            array.emplace<Triangle<int>>(Point<int>(x, 0), Point<int>(x + s, 0), Point<int>(x, 2 * s));
+        }
+    }
+    return array;
+}
+
+TEST(OrderingTest, SortByMatchesStableSort) {
+    FigureArray<int> array = makeOrderingArray(40000);
+    std::vector<const Figure<int>*> expected;
+    for (size_t i = 0; i < array.size(); ++i) expected.push_back(&array[i]);
+    std::stable_sort(expected.begin(), expected.end(), [](const Figure<int>* a, const Figure<int>* b) {
+        return a->calculateArea() > b->calculateArea();
+    });
+
+    ThreadPool pool(4);
+    array.sortBy(AreaKey{}, SortOrder::Descending, pool);
+    ASSERT_EQ(array.size(), expected.size());
+    for (size_t i = 0; i < array.size(); ++i) {
+        ASSERT_EQ(&array[i], expected[i]) << "position " << i;
+    }
+
+    array.sortBy(CentroidXKey{}, SortOrder::Ascending, pool);
+    for (size_t i = 1; i < array.size(); ++i) {
+        EXPECT_LE(array[i - 1].getCentroid().getX(), array[i].getCentroid().getX());
+    }
+}
+
+TEST(OrderingTest, TopKAndNthElement) {
+    FigureArray<int> array = makeOrderingArray(150000);
+    std::vector<double> areas;
+    for (size_t i = 0; i < array.size(); ++i) areas.push_back(array[i].calculateArea());
+    std::sort(areas.begin(), areas.end(), std::greater<double>());
+    double total = array.stats().totalArea;
+
+    array.topK(1000, AreaKey{});
+    ASSERT_EQ(array.size(), 150000u);
+    for (size_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(array[i].calculateArea(), areas[i]) << "position " << i;
+    }
+    EXPECT_NEAR(array.stats().totalArea, total, 1e-9 * total);
+    EXPECT_EQ(array.stats().count, 150000u);
+
+    size_t n = 75000;
+    array.nthElement(n, AreaKey{});
+    double pivot = array[n].calculateArea();
+    std::vector<double> ascending(areas.rbegin(), areas.rend());
+    EXPECT_EQ(pivot, ascending[n]);
+    for (size_t i = 0; i < array.size(); i += 97) {
+        if (i < n) {
+            EXPECT_LE(array[i].calculateArea(), pivot);
+        }
+        if (i > n) {
+            EXPECT_GE(array[i].calculateArea(), pivot);
+        }
+    }
+    EXPECT_THROW(array.nthElement(array.size(), AreaKey{}), std::out_of_range);
+}
+
+TEST(OrderingTest, NanKeysGoAfterInfinity) {
+    // NaN стоит раньше +inf в исходном порядке, но должен оказаться после него
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<double> keys{nan, inf, 1.0, nan, -inf, inf, 0.5};
+    FigureArray<int> array = makeOrderingArray(keys.size());
+    std::map<const Figure<int>*, size_t> original;
+    for (size_t i = 0; i < array.size(); ++i) original[&array[i]] = i;
+    auto key = [&](const Figure<int>& figure) { return keys[original.at(&figure)]; };
+    auto order = [&]() {
+        std::vector<size_t> result;
+        for (size_t i = 0; i < array.size(); ++i) result.push_back(original.at(&array[i]));
+        return result;
+    };
+
+    array.sortBy(key, SortOrder::Ascending);
+    EXPECT_EQ(order(), (std::vector<size_t>{4, 6, 2, 1, 5, 0, 3}));
+    array.sortBy(key, SortOrder::Descending);
+    EXPECT_EQ(order(), (std::vector<size_t>{1, 5, 2, 6, 4, 0, 3}));
+
+    array.topK(3, key);
+    EXPECT_EQ(order(), (std::vector<size_t>{1, 5, 2, 6, 4, 0, 3}));
+    array.nthElement(5, key);
+    for (size_t i = 0; i < array.size(); ++i) {
+        EXPECT_EQ(std::isnan(keys[order()[i]]), i >= 5) << "position " << i;
+    }
+}
+
+// Тесты для поиска пересечений фигур
+TEST(CollisionTest, SeparatingAxisCases) {
+    // Прямоугольники пересекаются, но треугольники разделены диагональю
+    Triangle<double> lower(Point<double>(0, 0), Point<double>(4, 0), Point<double>(0, 4));
+    Triangle<double> upper(Point<double>(4, 4), Point<double>(2.5, 4), Point<double>(4, 2.5));
+    EXPECT_FALSE(figuresIntersect<double>(lower, upper));
+
+    Triangle<double> touching(Point<double>(4, 4), Point<double>(2, 4), Point<double>(4, 0));
+    EXPECT_TRUE(figuresIntersect<double>(lower, touching));
+
+    // Повёрнутый квадрат (ромб) вокруг (5, 5) и квадрат, задевающий его вершину
+    Square<double> diamond(Point<double>(5, 3), Point<double>(7, 5), Point<double>(5, 7), Point<double>(3, 5));
+    Square<double> corner(Point<double>(6.5, 6.5), Point<double>(8, 6.5), Point<double>(8, 8), Point<double>(6.5, 8));
+    EXPECT_FALSE(figuresIntersect<double>(diamond, corner));
+    Square<double> inside(Point<double>(4.5, 4.5), Point<double>(5.5, 4.5), Point<double>(5.5, 5.5), Point<double>(4.5, 5.5));
+    EXPECT_TRUE(figuresIntersect<double>(diamond, inside));
+    EXPECT_TRUE(figuresIntersect<double>(inside, diamond));
+}
+
+TEST(CollisionTest, PairsMatchBruteForce) {
+    FigureArray<double> array;
+    unsigned seed = 777;
+    auto next = [&seed] { seed = seed * 1103515245u + 12345u; return static_cast<double>((seed >> 8) % 10000) / 10; };
+    for (int i = 0; i < 3000; ++i) {
+        double x = next();
+        double y = next();
+        double s = 1 + next() / 100;
+        switch (i % 3) {
+            case 0:
+                array.emplace<Triangle<double>>(Point<double>(x, y), Point<double>(x + s, y), Point<double>(x, y + s));
+                break;
+            case 1:
+                array.emplace<Square<double>>(Point<double>(x, y - s), Point<double>(x + s, y), Point<double>(x, y + s), Point<double>(x - s, y));
+                break;
+            default:
+                array.emplace<Rectangle<double>>(Point<double>(x, y), Point<double>(x + 2 * s, y), Point<double>(x + 2 * s, y + s), Point<double>(x, y + s));
+                break;
+        }
+    }
+
+    std::vector<std::pair<size_t, size_t>> expected;
+    for (size_t i = 0; i < array.size(); ++i) {
+        for (size_t j = i + 1; j < array.size(); ++j) {
+            if (figuresIntersect(array[i], array[j])) expected.emplace_back(i, j);
+        }
+    }
+    EXPECT_GT(expected.size(), 100u);
+
+    ThreadPool pool(3);
+    EXPECT_EQ(findIntersectingPairs(array, pool), expected);
+    EXPECT_TRUE(findIntersectingPairs(FigureArray<double>()).empty());
+}
+
+// Тесты для площади объединения
+TEST(UnionAreaTest, KnownCases) {
+    using P = Point<double>;
+    auto square = [](double x0, double y0, double side) {
+        return Square<double>(P(x0, y0), P(x0 + side, y0), P(x0 + side, y0 + side), P(x0, y0 + side));
+    };
+    FigureArray<double> array;
+    EXPECT_DOUBLE_EQ(computeUnionArea(array), 0.0);
+
+    // Осевые квадраты: перекрытие 1, вложенный квадрат ничего не добавляет
+    array.add(std::make_shared<Square<double>>(square(0, 0, 2)));
+    array.add(std::make_shared<Square<double>>(square(1, 1, 2)));
+    array.add(std::make_shared<Square<double>>(square(1.5, 1.5, 1)));
+    EXPECT_DOUBLE_EQ(computeUnionArea(array), 7.0);
+
+    // Треугольник поверх прямоугольника [11, 13] x [0, 2]: перекрытие 0.5
+    array.emplace<Triangle<double>>(P(10, 0), P(12, 0), P(10, 2));
+    array.emplace<Rectangle<double>>(P(11, 0), P(13, 0), P(13, 2), P(11, 2));
+    EXPECT_NEAR(computeUnionArea(array), 7.0 + 5.5, 1e-12);
+
+    // Повёрнутый квадрат и его копия, касание считается пересечением без площади
+    array.emplace<Square<double>>(P(20, -1), P(21, 0), P(20, 1), P(19, 0));
+    array.emplace<Square<double>>(P(20, -1), P(21, 0), P(20, 1), P(19, 0));
+    array.add(std::make_shared<Square<double>>(square(21, -1, 1)));
+    EXPECT_NEAR(computeUnionArea(array), 7.0 + 5.5 + 2.0 + 1.0, 1e-12);
+
+    // Без перекрытий площадь объединения совпадает с суммой площадей
+    FigureArray<double> disjoint;
+    for (int i = 0; i < 50; ++i) {
+        disjoint.emplace<Triangle<double>>(P(3 * i, 0), P(3 * i + 2, 0), P(3 * i, 2));
+    }
+    EXPECT_NEAR(computeUnionArea(disjoint), disjoint.computeTotalArea(), 1e-9);
+}
+
+TEST(UnionAreaTest, MatchesRasterization) {
+    using P = Point<double>;
+    unsigned seed = 4242;
+    auto next = [&seed](unsigned range) { seed = seed * 1103515245u + 12345u; return static_cast<int>((seed >> 8) % range); };
+
+    // Целочисленные прямоугольники: эталон - число покрытых единичных клеток
+    FigureArray<double> rectangles;
+    std::vector<std::vector<bool>> cells(60, std::vector<bool>(60, false));
+    for (int i = 0; i < 200; ++i) {
+        int x = next(50), y = next(50), w = 1 + next(10), h = 1 + next(10);
+        rectangles.emplace<Rectangle<double>>(P(x, y), P(x + w, y), P(x + w, y + h), P(x, y + h));
+        for (int cx = x; cx < x + w; ++cx) {
+            for (int cy = y; cy < y + h; ++cy) cells[cx][cy] = true;
+        }
+    }
+    double covered = 0;
+    for (const auto& column : cells) covered += static_cast<double>(std::count(column.begin(), column.end(), true));
+    ThreadPool pool(3);
+    EXPECT_DOUBLE_EQ(computeUnionArea(rectangles, pool), covered);
+
+    // Тот же набор через общий путь для многоугольников
+    auto shapes = collision_detail::buildShapes(rectangles, pool);
+    auto pairs = collision_detail::intersectingPairs(shapes, pool);
+    std::vector<size_t> members(shapes.size());
+    for (size_t i = 0; i < members.size(); ++i) members[i] = i;
+    EXPECT_NEAR(union_area_detail::polygonUnion(shapes, members.data(), members.size(), pairs.data(), pairs.size()), covered, 1e-9);
+
+    // Треугольники: эталон - доля покрытых центров мелкой сетки
+    FigureArray<double> triangles;
+    for (int i = 0; i < 150; ++i) {
+        triangles.emplace<Triangle<double>>(P(next(40), next(40)), P(next(40), next(40)), P(next(40), next(40)));
+    }
+    auto covers = [](const Figure<double>& triangle, double x, double y) {
+        double signs[3];
+        for (size_t v = 0; v < 3; ++v) {
+            P a = triangle.getVertex(v), b = triangle.getVertex((v + 1) % 3);
+            signs[v] = (b.getX() - a.getX()) * (y - a.getY()) - (b.getY() - a.getY()) * (x - a.getX());
+        }
+        return (signs[0] >= 0 && signs[1] >= 0 && signs[2] >= 0) || (signs[0] <= 0 && signs[1] <= 0 && signs[2] <= 0);
+    };
+    constexpr int resolution = 300;
+    double step = 40.0 / resolution;
+    size_t inside = 0;
+    for (int gx = 0; gx < resolution; ++gx) {
+        for (int gy = 0; gy < resolution; ++gy) {
+            for (size_t t = 0; t < triangles.size(); ++t) {
+                if (covers(triangles[t], (gx + 0.5) * step, (gy + 0.5) * step)) {
+                    ++inside;
+                    break;
+                }
+            }
+        }
+    }
+    double estimate = static_cast<double>(inside) * step * step;
+    double exact = computeUnionArea(triangles, pool);
+    EXPECT_NEAR(exact, estimate, estimate * 0.01);
+    EXPECT_EQ(exact, computeUnionArea(triangles, defaultThreadPool()));
+}
+
+// Тесты для кэша площади и центроида
+class CountingSquare : public Square<int> {
+public:
+    mutable int areaCalls = 0;
+    mutable int centroidCalls = 0;
+
+    using Square<int>::Square;
+
+    double calculateArea() const override {
+        ++areaCalls;
+        return Square<int>::calculateArea();
+    }
+
+    Point<int> getCentroid() const override {
+        ++centroidCalls;
+        return Square<int>::getCentroid();
+    }
+};
+
+TEST(FigureCacheTest, DisabledByDefault) {
+    CountingSquare square(Point<int>(0, 0), Point<int>(2, 0), Point<int>(2, 2), Point<int>(0, 2));
+    EXPECT_FALSE(square.isCaching());
+    EXPECT_NEAR(static_cast<double>(square), 4.0, 0.001);
+    EXPECT_NEAR(static_cast<double>(square), 4.0, 0.001);
+    EXPECT_EQ(square.areaCalls, 2);
+}
+
+TEST(FigureCacheTest, ComputesOnceUntilVerticesChange) {
+    CountingSquare square(Point<int>(0, 0), Point<int>(2, 0), Point<int>(2, 2), Point<int>(0, 2));
+    square.setCaching(true);
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_NEAR(static_cast<double>(square), 4.0, 0.001);
+        EXPECT_EQ(square.centroid(), Point<int>(1, 1));
+    }
+    EXPECT_EQ(square.areaCalls, 1);
+    EXPECT_EQ(square.centroidCalls, 1);
+
+    BoundingBox<int> box = square.boundingBox();
+    EXPECT_EQ(box.minX, 0);
+    EXPECT_EQ(box.maxY, 2);
+
+    // Ввод новых вершин сбрасывает кэш
+    std::istringstream is("1 1 4 1 4 4 1 4");
+    is >> square;
+    EXPECT_NEAR(static_cast<double>(square), 9.0, 0.001);
+    EXPECT_EQ(square.areaCalls, 2);
+    EXPECT_EQ(square.boundingBox().maxX, 4);
+
+    // Присваивание переносит состояние кэша другой фигуры
+    square = CountingSquare(Point<int>(0, 0), Point<int>(1, 0), Point<int>(1, 1), Point<int>(0, 1));
+    EXPECT_FALSE(square.isCaching());
+    EXPECT_NEAR(static_cast<double>(square), 1.0, 0.001);
+}
+
+TEST(FigureCacheTest, StoredOutOfLine) {
+    // Без кэша фигура платит только за указатель на него
+    EXPECT_LE(sizeof(Figure<double>), 3 * sizeof(void*));
+
+    Square<double> square(Point<double>(0, 0), Point<double>(2, 0), Point<double>(2, 2), Point<double>(0, 2));
+    square.setCaching(true);
+    EXPECT_NEAR(square.area(), 4.0, 0.001);
+
+    Square<double> copy(square);
+    EXPECT_TRUE(copy.isCaching());
+    EXPECT_TRUE(square.isCaching());
+    EXPECT_EQ(copy.boundingBox().maxX, 2.0);
+
+    Square<double> moved(std::move(copy));
+    EXPECT_TRUE(moved.isCaching());
+    EXPECT_NEAR(moved.area(), 4.0, 0.001);
+
+    moved.setCaching(false);
+    EXPECT_FALSE(moved.isCaching());
+    EXPECT_NEAR(moved.area(), 4.0, 0.001);
+}
+
+TEST(FigureCacheTest, FigureArrayAggregatesUseCache) {
+    FigureArray<int> array;
+    auto square = std::make_shared<CountingSquare>(Point<int>(0, 0), Point<int>(2, 0), Point<int>(2, 2), Point<int>(0, 2));
+    array.add(square);
+    array.add(std::make_shared<Triangle<int>>(Point<int>(0, 0), Point<int>(3, 0), Point<int>(0, 4)));
+    array.setCaching(true);
+
+    // add учитывает площадь в stats(), поэтому считаются вызовы после включения кэша
+    int callsBefore = square->areaCalls;
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_NEAR(array.computeTotalArea(), 10.0, 0.001);
+    }
+    EXPECT_EQ(square->areaCalls, callsBefore + 1);
+    EXPECT_TRUE(array[1].isCaching());
+}
+
+// Тесты для пространственного индекса
+static void addRandomFigure(FigureArray<double>& array, unsigned& seed) {
+    auto next = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<double>((seed >> 8) % 10000) / 10.0;
+    };
+    double x = next();
+    double y = next();
+    double s = 1.0 + next() / 100.0;
+    switch (static_cast<int>(next()) % 3) {
+        case 0:
+            array.add(std::make_shared<Triangle<double>>(
+                Point<double>(x, y), Point<double>(x + s, y), Point<double>(x, y + s)));
+            break;
+        case 1:
+            array.add(std::make_shared<Square<double>>(
+                Point<double>(x, y), Point<double>(x + s, y), Point<double>(x + s, y + s), Point<double>(x, y + s)));
+            break;
+        default:
+            array.add(std::make_shared<Rectangle<double>>(
+                Point<double>(x, y), Point<double>(x + 2 * s, y), Point<double>(x + 2 * s, y + s), Point<double>(x, y + s)));
+            break;
+    }
+}
+
+template <typename Ownership>
+static std::vector<size_t> bruteWindow(const FigureArray<double, Ownership>& array, const BoundingBox<double>& window) {
+    std::vector<size_t> result;
+    for (size_t i = 0; i < array.size(); ++i) {
+        if (array[i].boundingBox().intersects(window)) result.push_back(i);
+    }
+    return result;
+}
+
+template <typename Ownership>
+static size_t bruteNearest(const FigureArray<double, Ownership>& array, const Point<double>& p) {
+    size_t best = 0;
+    double bestDistance = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < array.size(); ++i) {
+        Point<double> c = array[i].getCentroid();
+        double d = std::pow(c.getX() - p.getX(), 2) + std::pow(c.getY() - p.getY(), 2);
+        if (d < bestDistance) {
+            bestDistance = d;
+            best = i;
+        }
+    }
+    return best;
+}
+
+TEST(SpatialIndexTest, QueriesMatchLinearScan) {
+    FigureArray<double> array;
+    unsigned seed = 17;
+    for (int i = 0; i < 3000; ++i) addRandomFigure(array, seed);
+
+    SpatialIndex<double> index(array);
+    EXPECT_EQ(index.size(), array.size());
+    for (int q = 0; q < 50; ++q) {
+        double x = q * 19.0;
+        double y = 1000.0 - q * 17.0;
+        BoundingBox<double> window{x, y, x + 40.0, y + 25.0};
+        EXPECT_EQ(index.queryWindow(window), bruteWindow(array, window));
+
+        Point<double> p(x, y);
+        EXPECT_EQ(index.nearestCentroid(p).value(), bruteNearest(array, p));
+    }
+}
+
+TEST(SpatialIndexTest, PointQueryUsesExactShape) {
+    FigureArray<int> array;
+    array.add(std::make_shared<Triangle<int>>(Point<int>(0, 0), Point<int>(4, 0), Point<int>(0, 4)));
+    array.add(std::make_shared<Square<int>>(Point<int>(2, 2), Point<int>(6, 2), Point<int>(6, 6), Point<int>(2, 6)));
+    SpatialIndex<int> index(array);
+
+    EXPECT_EQ(index.queryPoint(Point<int>(1, 1)), std::vector<size_t>{0});
+    // Точка в ограничивающем прямоугольнике треугольника, но вне самого треугольника
+    EXPECT_EQ(index.queryPoint(Point<int>(3, 3)), std::vector<size_t>{1});
+    EXPECT_EQ(index.queryPoint(Point<int>(2, 2)), (std::vector<size_t>{0, 1}));
+    EXPECT_TRUE(index.queryPoint(Point<int>(10, 10)).empty());
+}
+
+TEST(SpatialIndexTest, TracksAddAndErase) {
+    FigureArray<double> array;
+    unsigned seed = 5;
+    for (int i = 0; i < 500; ++i) addRandomFigure(array, seed);
+    SpatialIndex<double> index(array);
+
+    for (int step = 0; step < 600; ++step) {
+        if (step % 3 == 0 && array.size() > 0) {
+            size_t victim = (step * 7) % array.size();
+            array.erase(victim);
+            index.onErase(victim);
+        } else if (step % 3 == 1 && array.size() > 0) {
+            size_t victim = (step * 13) % array.size();
+            array.eraseUnordered(victim);
+            index.onEraseUnordered(victim);
+        } else {
+            addRandomFigure(array, seed);
+            index.onAdd();
+        }
+
+        if (step % 50 == 0) {
+            BoundingBox<double> window{100.0, 100.0, 600.0, 400.0};
+            ASSERT_EQ(index.queryWindow(window), bruteWindow(array, window)) << "step " << step;
+            Point<double> p(step * 1.5, 500.0);
+            ASSERT_EQ(index.nearestCentroid(p).value(), bruteNearest(array, p)) << "step " << step;
+        }
+    }
+    EXPECT_EQ(index.size(), array.size());
+}
+
+TEST(SpatialIndexTest, IndexesNonSharedOwnership) {
+    FigureArray<double> source;
+    unsigned seed = 41;
+    for (int i = 0; i < 400; ++i) addRandomFigure(source, seed);
+
+    // Фигуры лежат прямо в массиве (ValueOwnership)
+    FigureArray<double, ValueOwnership> array;
+    auto copyFigure = [&](const Figure<double>& figure) {
+        if (figure.kind() == FigureKind::Triangle) {
+            array.emplace<Triangle<double>>(static_cast<const Triangle<double>&>(figure));
+        } else if (figure.kind() == FigureKind::Square) {
+            array.emplace<Square<double>>(static_cast<const Square<double>&>(figure));
+        } else {
+            array.emplace<Rectangle<double>>(static_cast<const Rectangle<double>&>(figure));
+        }
+    };
+    for (size_t i = 0; i < 300; ++i) copyFigure(source[i]);
+
+    SpatialIndex index(array);
+    static_assert(std::is_same_v<decltype(index), SpatialIndex<double, ValueOwnership>>);
+    for (size_t i = 300; i < source.size(); ++i) {
+        copyFigure(source[i]);
+        index.onAdd();
+        if (i % 3 == 0) {
+            size_t victim = i % array.size();
+            array.eraseUnordered(victim);
+            index.onEraseUnordered(victim);
+        }
+    }
+    array.erase(5);
+    index.onErase(5);
+
+    EXPECT_EQ(index.size(), array.size());
+    for (int q = 0; q < 20; ++q) {
+        BoundingBox<double> window{q * 40.0, q * 30.0, q * 40.0 + 120.0, q * 30.0 + 90.0};
+        EXPECT_EQ(index.queryWindow(window), bruteWindow(array, window));
+        Point<double> p(q * 45.0, 900.0 - q * 35.0);
+        EXPECT_EQ(index.nearestCentroid(p).value(), bruteNearest(array, p));
+    }
+}
+
+TEST(SpatialIndexTest, LevelsStayConsistentUnderChurn) {
+    FigureArray<double> array;
+    unsigned seed = 29;
+    SpatialIndex<double> index(array);
+    EXPECT_FALSE(index.nearestCentroid(Point<double>(0, 0)).has_value());
+
+    // Вставки сливаются в уровни, удаления из середины оставляют пропуски в номерах ячеек
+    for (int step = 0; step < 4000; ++step) {
+        if (step % 5 == 3 && array.size() > 0) {
+            size_t victim = (step * 31) % array.size();
+            array.erase(victim);
+            index.onErase(victim);
+        } else if (step % 5 == 4 && array.size() > 0) {
+            size_t victim = (step * 17) % array.size();
+            array.eraseUnordered(victim);
+            index.onEraseUnordered(victim);
+        } else if (step % 7 == 6 && array.size() > 0) {
+            size_t target = (step * 11) % array.size();
+            if (array[target].kind() == FigureKind::Square) {
+                double x = step % 900;
+                static_cast<Square<double>&>(array[target]) = Square<double>(
+                    Point<double>(x, 50), Point<double>(x + 5, 50), Point<double>(x + 5, 55), Point<double>(x, 55));
+            }
+            index.onUpdate(target);
+        } else {
+            addRandomFigure(array, seed);
+            index.onAdd();
+        }
+
+        if (step % 250 == 0) {
+            BoundingBox<double> window{200.0, 0.0, 700.0, 600.0};
+            ASSERT_EQ(index.queryWindow(window), bruteWindow(array, window)) << "step " << step;
+            Point<double> p(step % 1000, 300.0);
+            ASSERT_EQ(index.nearestCentroid(p).value(), bruteNearest(array, p)) << "step " << step;
+        }
+    }
+    EXPECT_EQ(index.size(), array.size());
+}
+
+// Тесты для двоичного формата файла фигур
+TEST(BinaryIoTest, RoundTripPreservesOrder) {
+    FigureArray<double> array;
+    unsigned seed = 3;
+    for (int i = 0; i < 1000; ++i) addRandomFigure(array, seed);
+
+    std::stringstream stream;
+    writeFigureArray(stream, array);
+    FigureArray<double> loaded = readFigureArray<double>(stream);
+
+    ASSERT_EQ(loaded.size(), array.size());
+    for (size_t i = 0; i < array.size(); ++i) {
+        EXPECT_TRUE(loaded[i] == array[i]) << "figure " << i;
+    }
+}
+
+TEST(BinaryIoTest, GroupByKindWritesOneChunkPerKind) {
+    FigureArray<int> array;
+    for (int i = 0; i < 30; ++i) {
+        if (i % 2 == 0) {
+            array.add(std::make_shared<Square<int>>(Point<int>(i, 0), Point<int>(i + 1, 0), Point<int>(i + 1, 1), Point<int>(i, 1)));
+        } else {
+            array.add(std::make_shared<Triangle<int>>(Point<int>(i, 0), Point<int>(i + 2, 0), Point<int>(i, 2)));
+        }
+    }
+
+    std::stringstream stream;
+    writeFigureArray(stream, array, FigureOrder::GroupByKind);
+    FigureBinaryReader<int> reader(stream);
+    EXPECT_EQ(reader.figureCount(), 30u);
+
+    std::vector<FigureChunkInfo> chunks;
+    FigureChunkInfo info;
+    while (reader.nextChunk(info)) chunks.push_back(info);
+    ASSERT_EQ(chunks.size(), 2u);
+    EXPECT_EQ(chunks[0].kind, FigureKind::Triangle);
+    EXPECT_EQ(chunks[0].count, 15u);
+    EXPECT_EQ(chunks[1].kind, FigureKind::Square);
+    EXPECT_EQ(chunks[1].vertexCount, 4u);
+}
+
+TEST(BinaryIoTest, ReaderSkipsAndLoadsSelectedChunks) {
+    FigureArray<float> array;
+    for (int i = 0; i < 10; ++i) array.add(std::make_shared<Triangle<float>>());
+    for (int i = 0; i < 5; ++i) array.add(std::make_shared<Rectangle<float>>());
+
+    std::stringstream stream;
+    writeFigureArray(stream, array);
+    FigureBinaryReader<float> reader(stream);
+
+    // Треугольники пропускаются, прямоугольники загружаются в колоночное хранилище
+    FigureColumnStore<float> store;
+    FigureChunkInfo info;
+    while (reader.nextChunk(info)) {
+        if (info.kind == FigureKind::Rectangle) {
+            reader.readChunk(store);
+        } else {
+            reader.skipChunk();
+        }
+    }
+    ASSERT_EQ(store.size(), 5u);
+    EXPECT_NEAR(store.computeTotalArea(), 10.0, EPS);
+}
+
+TEST(BinaryIoTest, RejectsMismatchedOrDamagedFiles) {
+    FigureArray<int> array;
+    array.add(std::make_shared<Square<int>>());
+    std::stringstream stream;
+    writeFigureArray(stream, array);
+    std::string data = stream.str();
+
+    std::stringstream wrongType(data);
+    EXPECT_THROW(readFigureArray<double>(wrongType), std::runtime_error);
+
+    std::stringstream truncated(data.substr(0, data.size() - 20));
+    EXPECT_THROW(readFigureArray<int>(truncated), std::runtime_error);
+
+    std::string badMagic = data;
+    badMagic[0] = 'X';
+    std::stringstream notFigures(badMagic);
+    EXPECT_THROW(readFigureArray<int>(notFigures), std::runtime_error);
+
+    std::stringstream out;
+    FigureBinaryWriter<int> writer(out, 2);
+    writer.write(array[0]);
+    EXPECT_THROW(writer.finish(), std::logic_error);
+}
+
+// Поток без позиционирования: длина остатка неизвестна читателю
+class ForwardOnlyBuffer : public std::streambuf {
+public:
+    explicit ForwardOnlyBuffer(std::string& data) {
+        setg(data.data(), data.data(), data.data() + data.size());
+    }
+};
+
+TEST(BinaryIoTest, RejectsHostileSizesBeforeAllocating) {
+    FigureArray<int> array;
+    array.add(std::make_shared<Square<int>>());
+    array.add(std::make_shared<Triangle<int>>());
+    std::stringstream stream;
+    writeFigureArray(stream, array);
+    std::string data = stream.str();
+
+    // Заявленное число фигур не помещается в файл
+    std::string hugeCount = data;
+    uint64_t figureCount = uint64_t(1) << 60;
+    std::memcpy(hugeCount.data() + 16, &figureCount, sizeof(figureCount));
+    std::stringstream countStream(hugeCount);
+    EXPECT_THROW(readFigureArray<int>(countStream), std::runtime_error);
+    std::stringstream countColumns(hugeCount);
+    EXPECT_THROW(readFigureColumnStore<int>(countColumns), std::runtime_error);
+
+    // Фрагмент с согласованным, но огромным размером данных
+    std::string hugeChunk = data;
+    uint32_t chunkCount = 0xFFFFFFF0u;
+    uint64_t payload = uint64_t(2) * 4 * chunkCount * sizeof(int);
+    std::memcpy(hugeChunk.data() + 36, &chunkCount, sizeof(chunkCount));
+    std::memcpy(hugeChunk.data() + 40, &payload, sizeof(payload));
+    std::stringstream chunkStream(hugeChunk);
+    EXPECT_THROW(readFigureArray<int>(chunkStream), std::runtime_error);
+
+    // Без известной длины память растёт только вместе с прочитанными данными
+    ForwardOnlyBuffer countBuffer(hugeCount);
+    std::istream forwardCount(&countBuffer);
+    EXPECT_THROW(readFigureArray<int>(forwardCount), std::runtime_error);
+    ForwardOnlyBuffer chunkBuffer(hugeChunk);
+    std::istream forwardChunk(&chunkBuffer);
+    EXPECT_THROW(readFigureColumnStore<int>(forwardChunk), std::runtime_error);
+
+    // Исходные данные читаются и через поток без позиционирования
+    ForwardOnlyBuffer intactBuffer(data);
+    std::istream forward(&intactBuffer);
+    EXPECT_EQ(readFigureArray<int>(forward).size(), 2u);
+}
+
+// Тесты для отображения файла фигур в память
+TEST(MappedViewTest, MatchesFigureArray) {
+    FigureArray<double> array;
+    unsigned seed = 11;
+    for (int i = 0; i < 5000; ++i) addRandomFigure(array, seed);
+
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "figures_mapped_view_test.bin";
+    {
+        std::ofstream out(path, std::ios::binary);
+        writeFigureArray(out, array, FigureOrder::GroupByKind);
+    }
+
+    MappedFigureView<double> view(path.string());
+    ASSERT_EQ(view.size(), array.size());
+    EXPECT_EQ(view.chunkCount(), 3u);
+    EXPECT_NEAR(view.computeTotalArea(), array.computeTotalArea(), 1e-6);
+    EXPECT_NEAR(view.computeTotalAreaParallel(), view.computeTotalArea(), 1e-6);
+
+    // Фигуры сгруппированы по видам, поэтому сравнивается мультимножество центроидов
+    std::vector<Point<double>> expected, actual;
+    for (size_t i = 0; i < array.size(); ++i) expected.push_back(array[i].getCentroid());
+    view.computeCentroids(actual);
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    EXPECT_EQ(actual, expected);
+    EXPECT_EQ(view.computeCentroidsParallel().size(), array.size());
+
+    std::vector<double> areas, batchAreas;
+    view.computeAreas(areas);
+    view.computeAreasBatch(batchAreas);
+    for (size_t i = 0; i < areas.size(); ++i) {
+        EXPECT_NEAR(batchAreas[i], areas[i], 1e-6);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(MappedViewTest, AreasAreBitIdenticalToFigures) {
+    FigureArray<double> array;
+    unsigned seed = 23;
+    for (int i = 0; i < 2000; ++i) addRandomFigure(array, seed);
+
+    std::stringstream stream;
+    writeFigureArray(stream, array, FigureOrder::Preserve);
+    std::vector<uint64_t> buffer((stream.str().size() + 7) / 8);
+    std::memcpy(buffer.data(), stream.str().data(), stream.str().size());
+    MappedFigureView<double> view(buffer.data(), stream.str().size());
+
+    ASSERT_EQ(view.size(), array.size());
+    std::vector<double> areas;
+    view.computeAreas(areas);
+    for (size_t i = 0; i < array.size(); ++i) {
+        EXPECT_EQ(view.calculateArea(i), array[i].calculateArea()) << "figure " << i;
+        EXPECT_EQ(areas[i], array[i].calculateArea()) << "figure " << i;
+    }
+    EXPECT_EQ(view.computeTotalArea(), array.computeTotalArea());
+    EXPECT_EQ(view.computeTotalAreaParallel(), array.computeTotalAreaParallel());
+}
+
+TEST(MappedViewTest, RandomAccessFromBuffer) {
+    FigureArray<int> array;
+    array.add(std::make_shared<Square<int>>(Point<int>(0, 0), Point<int>(3, 0), Point<int>(3, 3), Point<int>(0, 3)));
+    array.add(std::make_shared<Triangle<int>>(Point<int>(0, 0), Point<int>(4, 0), Point<int>(0, 4)));
+    array.add(std::make_shared<Square<int>>(Point<int>(1, 1), Point<int>(2, 1), Point<int>(2, 2), Point<int>(1, 2)));
+
+    std::stringstream stream;
+    writeFigureArray(stream, array);
+    std::vector<uint64_t> buffer((stream.str().size() + 7) / 8);
+    std::memcpy(buffer.data(), stream.str().data(), stream.str().size());
+
+    MappedFigureView<int> view(buffer.data(), stream.str().size());
+    ASSERT_EQ(view.size(), 3u);
+    EXPECT_EQ(view.chunkCount(), 3u);
+    EXPECT_EQ(view.kind(1), FigureKind::Triangle);
+    EXPECT_EQ(view.vertexCount(1), 3u);
+    EXPECT_EQ(view.getVertex(2, 2), Point<int>(2, 2));
+    EXPECT_DOUBLE_EQ(view.calculateArea(0), 9.0);
+    EXPECT_DOUBLE_EQ(view.calculateArea(1), 8.0);
+    EXPECT_EQ(view.getCentroid(2), Point<int>(1, 1));
+    EXPECT_THROW(view.getVertex(3, 0), std::out_of_range);
+    EXPECT_THROW(view.getVertex(1, 3), std::out_of_range);
+
+    EXPECT_THROW(MappedFigureView<int>(buffer.data(), 40), std::runtime_error);
+    EXPECT_THROW(MappedFigureView<int>("/nonexistent/figures.bin"), std::runtime_error);
+}
+
+// Тесты для пакетной загрузки текста
+TEST(TextLoaderTest, LoadsRecordsIntoArray) {
+    std::string text =
+        "# dump\n"
+        "square 0 0 2 0 2 2 0 2\n"
+        "\n"
+        "  triangle 0,0, 3,0, 0,4\r\n"
+        "rectangle -1 -1 +3 -1 3 1 -1 1";
+
+    FigureArray<int> array;
+    TextLoadResult result = loadFiguresText(text, array);
+    EXPECT_TRUE(result.ok());
+    EXPECT_EQ(result.loaded, 3u);
+    EXPECT_EQ(result.lines, 5u);
+    ASSERT_EQ(array.size(), 3u);
+    EXPECT_TRUE(array[0] == Square<int>(Point<int>(0, 0), Point<int>(2, 0), Point<int>(2, 2), Point<int>(0, 2)));
+    EXPECT_TRUE(array[1] == Triangle<int>(Point<int>(0, 0), Point<int>(3, 0), Point<int>(0, 4)));
+    EXPECT_DOUBLE_EQ(static_cast<double>(array[2]), 8.0);
+}
+
+TEST(TextLoaderTest, ReportsMalformedLines) {
+    std::string text =
+        "square 0 0 1 0 1 1 0 1\n"
+        "hexagon 0 0\n"
+        "triangle 0 0 1 0\n"
+        "triangle 0 0 1 x 0 1\n"
+        "square 0 0 1 0 1 1 0 1 7\n"
+        "triangle 0.5 0 1 0 0 1\n"
+        "triangle 0 0 2 0 0 2\n";
+
+    FigureColumnStore<int> store;
+    TextLoadResult result = loadFiguresText(text, store, 3);
+    EXPECT_EQ(result.loaded, 2u);
+    EXPECT_EQ(result.errorCount, 5u);
+    ASSERT_EQ(result.errors.size(), 3u);
+    EXPECT_EQ(result.errors[0].line, 2u);
+    EXPECT_EQ(result.errors[1].line, 3u);
+    EXPECT_EQ(result.errors[2].line, 4u);
+    EXPECT_NE(result.errors[2].message.find("'x'"), std::string::npos);
+    EXPECT_EQ(store.size(), 2u);
+    EXPECT_EQ(store.kind(1), FigureKind::Triangle);
+}
+
+TEST(TextLoaderTest, RejectsInvalidVertices) {
+    std::string text =
+        "triangle 0 0 1 1 2 2\n"
+        "square 0 0 2 0 2 2 0 2\n"
+        "square 0 0 3 0 3 1 0 1\n"
+        "rectangle 0 0 0 0 1 1 0 1\n"
+        "rectangle 0 0 3 0 3 1 0 1\n";
+
+    FigureArray<double> array;
+    TextLoadResult result = loadFiguresText(text, array);
+    EXPECT_EQ(result.loaded, 2u);
+    EXPECT_EQ(result.errorCount, 3u);
+    ASSERT_EQ(result.errors.size(), 3u);
+    EXPECT_EQ(result.errors[0].line, 1u);
+    EXPECT_EQ(result.errors[0].message, "invalid triangle vertices");
+    EXPECT_EQ(result.errors[1].line, 3u);
+    EXPECT_EQ(result.errors[1].message, "invalid square vertices");
+    EXPECT_EQ(result.errors[2].line, 4u);
+    ASSERT_EQ(array.size(), 2u);
+    for (size_t i = 0; i < array.size(); ++i) {
+        EXPECT_TRUE(array[i].checkValidity());
+    }
+
+    FigureColumnStore<int> store;
+    result = loadFiguresText(text, store);
+    EXPECT_EQ(result.loaded, 2u);
+    EXPECT_EQ(store.countValid(), store.size());
+}
+
+TEST(TextLoaderTest, LoadsMappedFile) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "figures_text_loader_test.txt";
+    {
+        std::ofstream out(path);
+        for (int i = 0; i < 1000; ++i) {
+            out << "rectangle " << i << " 0 " << i + 2 << " 0 " << i + 2 << " 1.5 " << i << " 1.5\n";
+        }
+    }
+
+    FigureColumnStore<double> store;
+    TextLoadResult result = loadFiguresTextFile<double>(path.string(), store);
+    EXPECT_TRUE(result.ok());
+    EXPECT_EQ(store.size(), 1000u);
+    EXPECT_NEAR(store.computeTotalArea(), 3000.0, 1e-9);
+    std::filesystem::remove(path);
+}
+
+// Тесты для буферизованной записи отчётов
+static FigureArray<double> makeReportArray() {
+    FigureArray<double> array;
+    array.add(std::make_shared<Square<double>>(Point<double>(0, 0), Point<double>(2, 0), Point<double>(2, 2), Point<double>(0, 2)));
+    array.add(std::make_shared<Triangle<double>>(Point<double>(0, 0), Point<double>(3, 0), Point<double>(0, 4)));
+    return array;
+}
+
+TEST(ReportWriterTest, HumanFormatMatchesDisplay) {
+    FigureArray<double> array = makeReportArray();
+
+    std::ostringstream captured;
+    std::streambuf* old = std::cout.rdbuf(captured.rdbuf());
+    array.displayAreas();
+    std::cout.rdbuf(old);
+
+    std::string report;
+    {
+        StringSink sink(report);
+        ReportWriter writer(sink);
+        writer.writeAreas(array);
+    }
+    EXPECT_EQ(report, captured.str());
+    EXPECT_EQ(report.substr(0, report.find('\n')),
+              "0: Square: (0.00, 0.00), (2.00, 0.00), (2.00, 2.00), (0.00, 2.00) | Area = 4.00");
+}
+
+TEST(ReportWriterTest, CsvAndJsonLines) {
+    FigureArray<double> array = makeReportArray();
+
+    std::string csv;
+    {
+        StringSink sink(csv);
+        ReportWriter writer(sink, ReportFormat::Csv);
+        writer.writeAreas(array);
+        writer.writeCentroids(array);
+    }
+    EXPECT_EQ(csv, "index,kind,area\n0,square,4\n1,triangle,6\n"
+                   "index,x,y\n0,1,1\n1,1,1.3333333333333333\n");
+
+    std::string json;
+    {
+        StringSink sink(json);
+        ReportWriter writer(sink, ReportFormat::JsonLines);
+        writer.writeAreas(array);
+        writer.writeCentroidRow(7, Point<int>(-3, 5));
+    }
+    EXPECT_EQ(json, "{\"index\":0,\"kind\":\"square\",\"area\":4}\n"
+                    "{\"index\":1,\"kind\":\"triangle\",\"area\":6}\n"
+                    "{\"index\":7,\"x\":-3,\"y\":5}\n");
+}
+
+TEST(ReportWriterTest, ParallelAndFileSinksMatchSequential) {
+    FigureArray<double> array;
+    unsigned seed = 23;
+    for (int i = 0; i < 10000; ++i) addRandomFigure(array, seed);
+
+    std::string sequential, parallel;
+    {
+        StringSink sink(sequential);
+        ReportWriter writer(sink, ReportFormat::Csv, 2, 4096);
+        writer.writeCentroids(array);
+    }
+    {
+        StringSink sink(parallel);
+        ReportWriter writer(sink, ReportFormat::Csv);
+        writer.writeCentroidsParallel(array);
+    }
+    EXPECT_EQ(parallel, sequential);
+
+    auto readFile = [](const std::filesystem::path& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+
+    std::filesystem::path mappedPath = std::filesystem::temp_directory_path() / "figures_report_mapped.csv";
+    {
+        MappedFileSink sink(mappedPath.string(), 4096);
+        ReportWriter writer(sink, ReportFormat::Csv);
+        writer.writeCentroids(array);
+        writer.flush();
+        EXPECT_EQ(sink.size(), sequential.size());
+    }
+    EXPECT_EQ(readFile(mappedPath), sequential);
+    std::filesystem::remove(mappedPath);
+
+    std::filesystem::path fdPath = std::filesystem::temp_directory_path() / "figures_report_fd.csv";
+    {
+        int fd = ::open(fdPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        ASSERT_GE(fd, 0);
+        FdSink sink(fd);
+        {
+            ReportWriter writer(sink, ReportFormat::Csv);
+            writer.writeCentroids(array);
+        }
+        ::close(fd);
+    }
+    EXPECT_EQ(readFile(fdPath), sequential);
+    std::filesystem::remove(fdPath);
+}
+
+// Тесты для канонической формы и поиска повторов
+TEST(CanonicalTest, FormIsRotationInvariant) {
+    Square<double> a(Point<double>(0, 0), Point<double>(1, 0), Point<double>(1, 1), Point<double>(0, 1));
+    Square<double> b(Point<double>(1, 1), Point<double>(0, 1), Point<double>(0, 0), Point<double>(1, 0));
+    Square<double> c(Point<double>(0, 0), Point<double>(0, 1), Point<double>(1, 1), Point<double>(1, 0));
+    Rectangle<double> d(Point<double>(0, 0), Point<double>(1, 0), Point<double>(1, 1), Point<double>(0, 1));
+
+    EXPECT_EQ(canonicalForm(a), canonicalForm(b));
+    EXPECT_EQ(CanonicalFormHash()(canonicalForm(a)), CanonicalFormHash()(canonicalForm(b)));
+    // Обратный обход вершин и другой вид фигуры не равны и по operator==
+    EXPECT_FALSE(a == c);
+    EXPECT_NE(canonicalForm(a), canonicalForm(c));
+    EXPECT_NE(canonicalForm(a), canonicalForm(d));
+}
+
+TEST(CanonicalTest, FindDuplicatesMatchesPairwiseComparison) {
+    FigureArray<double> array;
+    unsigned seed = 31;
+    for (int i = 0; i < 300; ++i) addRandomFigure(array, seed);
+    // Повторы с циклическим сдвигом вершин и сдвигом координат меньше EPS
+    for (size_t i = 0; i < 300; i += 7) {
+        const Figure<double>& figure = array[i];
+        size_t n = figure.vertexCount();
+        Point<double> p[4];
+        for (size_t v = 0; v < n; ++v) {
+            Point<double> q = figure.getVertex((v + i) % n);
+            p[v] = Point<double>(q.getX() + 1e-9, q.getY());
+        }
+        if (figure.kind() == FigureKind::Triangle) {
+            array.add(std::make_shared<Triangle<double>>(p[0], p[1], p[2]));
+        } else if (figure.kind() == FigureKind::Square) {
+            array.add(std::make_shared<Square<double>>(p[0], p[1], p[2], p[3]));
+        } else {
+            array.add(std::make_shared<Rectangle<double>>(p[0], p[1], p[2], p[3]));
+        }
+    }
+
+    std::vector<std::vector<size_t>> expected;
+    std::vector<bool> seen(array.size(), false);
+    for (size_t i = 0; i < array.size(); ++i) {
+        if (seen[i]) continue;
+        std::vector<size_t> group{i};
+        for (size_t j = i + 1; j < array.size(); ++j) {
+            if (!seen[j] && array[i] == array[j]) {
+                group.push_back(j);
+                seen[j] = true;
+            }
+        }
+        if (group.size() > 1) expected.push_back(group);
+    }
+    EXPECT_EQ(array.findDuplicates(), expected);
+    EXPECT_GE(expected.size(), 43u);
+
+    size_t before = array.size();
+    size_t removed = array.dedup();
+    EXPECT_EQ(array.size(), before - removed);
+    EXPECT_TRUE(array.findDuplicates().empty());
+}
+
+TEST(CanonicalTest, FiguresStraddlingCellBoundaryAreGrouped) {
+    // Вершины отличаются меньше чем на EPS, но лежат по разные стороны границы ячейки
+    double boundary = 5.5 * canonicalQuantum;
+    double shift = 0.3 * EPS;
+    Square<double> a(Point<double>(boundary - shift, 0), Point<double>(1, 0), Point<double>(1, 1), Point<double>(boundary - shift, 1));
+    Square<double> b(Point<double>(1, 1), Point<double>(boundary + shift, 1), Point<double>(boundary + shift, 0), Point<double>(1, 0));
+    ASSERT_TRUE(a == b);
+    EXPECT_NE(canonicalForm(a), canonicalForm(b));
+
+    std::vector<CanonicalForm> forms = canonicalForms(a);
+    EXPECT_EQ(forms.front(), canonicalForm(a));
+    EXPECT_NE(std::find(forms.begin(), forms.end(), canonicalForm(b)), forms.end());
+
+    FigureArray<double> array;
+    array.add(std::make_shared<Square<double>>(a));
+    array.add(std::make_shared<Triangle<double>>());
+    array.add(std::make_shared<Square<double>>(b));
+    std::vector<std::vector<size_t>> expected{{0, 2}};
+    EXPECT_EQ(array.findDuplicates(), expected);
+
+    FigureArray<double> left;
+    left.add(std::make_shared<Square<double>>(b));
+    FigureArray<double> right;
+    right.add(std::make_shared<Square<double>>(a));
+    std::vector<std::pair<size_t, size_t>> matches{{0, 0}};
+    EXPECT_EQ(hashJoin(left, right), matches);
+
+    EXPECT_EQ(array.dedup(), 1u);
+    EXPECT_EQ(array.size(), 2u);
+    EXPECT_THROW(canonicalForm(a, EPS), std::invalid_argument);
+
+    // Целые координаты лежат в центрах ячеек: форма одна
+    EXPECT_EQ(canonicalForms(Square<int>(Point<int>(3, 3), Point<int>(5, 3), Point<int>(5, 5), Point<int>(3, 5))).size(), 1u);
+    EXPECT_EQ(canonicalForms(Triangle<double>(Point<double>(0.5, 0), Point<double>(1, 0), Point<double>(0, 1.25))).size(), 1u);
+}
+
+TEST(CanonicalTest, HashJoinFindsAllMatches) {
+    FigureArray<int> left;
+    FigureArray<int> right;
+    left.add(std::make_shared<Square<int>>());
+    left.add(std::make_shared<Triangle<int>>());
+    left.add(std::make_shared<Rectangle<int>>());
+    right.add(std::make_shared<Triangle<int>>(Point<int>(1, 0), Point<int>(0, 1), Point<int>(0, 0)));
+    right.add(std::make_shared<Square<int>>(Point<int>(5, 5), Point<int>(6, 5), Point<int>(6, 6), Point<int>(5, 6)));
+    right.add(std::make_shared<Square<int>>(Point<int>(1, 1), Point<int>(0, 1), Point<int>(0, 0), Point<int>(1, 0)));
+    right.add(std::make_shared<Square<int>>());
+
+    std::vector<std::pair<size_t, size_t>> expected{{0, 2}, {0, 3}, {1, 0}};
+    EXPECT_EQ(hashJoin(left, right), expected);
+}
+
+// Тесты для точной целочисленной арифметики
+TEST(ExactTest, TwiceAreaAndRationalCentroid) {
+    Triangle<int> t(Point<int>(0, 0), Point<int>(1, 0), Point<int>(0, 1));
+    EXPECT_EQ(exactTwiceArea(t), 1);
+    EXPECT_DOUBLE_EQ(t.calculateArea(), 0.5);
+
+    ExactPoint<int> centroid = exactCentroid(t);
+    EXPECT_EQ(centroid.x, ExactFraction<int>(1, 3));
+    EXPECT_EQ(centroid.y, ExactFraction<int>(2, 6));
+    EXPECT_FALSE(centroid.x.isInteger());
+    EXPECT_DOUBLE_EQ(centroid.toDouble().getX(), 1.0 / 3);
+
+    Square<int> s(Point<int>(1, 1), Point<int>(3, 1), Point<int>(3, 3), Point<int>(1, 3));
+    EXPECT_EQ(exactTwiceArea(s), 8);
+    EXPECT_TRUE(exactCentroid(s).x.isInteger());
+    EXPECT_EQ(exactCentroid(s).y.numerator, 2);
+}
+
+TEST(ExactTest, LargeCoordinatesStayExact) {
+    // Почти вырожденный треугольник со сторонами ~2e9: формула Герона в double теряет площадь 0.5
+    Triangle<int64_t> thin(Point<int64_t>(0, 0), Point<int64_t>(1000000000, 1), Point<int64_t>(2000000001, 2));
+    EXPECT_EQ(exactTwiceArea(thin), 1);
+    EXPECT_DOUBLE_EQ(thin.calculateArea(), 0.5);
+    EXPECT_TRUE(thin.checkValidity());
+
+    Triangle<int64_t> line(Point<int64_t>(0, 0), Point<int64_t>(1000000000, 1), Point<int64_t>(2000000000, 2));
+    EXPECT_FALSE(line.checkValidity());
+
+    const int64_t offset = int64_t(1) << 40;
+    Rectangle<int64_t> r(Point<int64_t>(offset, offset), Point<int64_t>(offset + 3, offset),
+                         Point<int64_t>(offset + 3, offset + 1), Point<int64_t>(offset, offset + 1));
+    EXPECT_TRUE(r.checkValidity());
+    EXPECT_DOUBLE_EQ(r.calculateArea(), 3.0);
+
+    Square<int64_t> notSquare(Point<int64_t>(offset, offset), Point<int64_t>(offset + 3, offset),
+                              Point<int64_t>(offset + 3, offset + 1), Point<int64_t>(offset, offset + 1));
+    EXPECT_FALSE(notSquare.checkValidity());
+}
+
+TEST(ExactTest, PortableInt128Arithmetic) {
+    using exact_detail::Int128;
+    static_assert(static_cast<double>(Int128(-3) * Int128(7) + Int128(1)) == -20.0);
+
+    // Произведения 64-битных разностей и деление с усечением к нулю
+    Int128 big = Int128(int64_t(1) << 62) * Int128(int64_t(3) << 60) - Int128(5);
+    EXPECT_EQ(big / Int128(int64_t(1) << 62), Int128(int64_t(3) << 60) - Int128(1));
+    EXPECT_EQ(big % Int128(int64_t(1) << 62), Int128((int64_t(1) << 62) - 5));
+    EXPECT_EQ(Int128(-7) / Int128(2), Int128(-3));
+    EXPECT_EQ(Int128(-7) % Int128(2), Int128(-1));
+    EXPECT_TRUE(Int128(-1) < Int128(0));
+    EXPECT_TRUE(-big < Int128(0));
+    EXPECT_DOUBLE_EQ(static_cast<double>(-big), -std::ldexp(3.0, 122));
+
+#if defined(__SIZEOF_INT128__)
+    unsigned seed = 17;
+    auto next = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<int64_t>(seed) * static_cast<int64_t>(seed * 2654435761u) - (int64_t(1) << 61);
+    };
+    auto fromBuiltin = [](__int128 value) {
+        Int128 half(int64_t(1) << 32);
+        return Int128(static_cast<int64_t>(value >> 64)) * half * half + Int128(static_cast<uint64_t>(value));
+    };
+    for (int i = 0; i < 1000; ++i) {
+        int64_t a = next(), b = next(), c = next();
+        __int128 expected = static_cast<__int128>(a) * b - static_cast<__int128>(c) * a;
+        Int128 actual = Int128(a) * Int128(b) - Int128(c) * Int128(a);
+        EXPECT_EQ(actual, fromBuiltin(expected));
+        EXPECT_EQ(static_cast<double>(actual), static_cast<double>(expected));
+        if (c == 0) continue;
+        EXPECT_EQ(actual / Int128(c), fromBuiltin(expected / c));
+        EXPECT_EQ(actual % Int128(c), fromBuiltin(expected % c));
+    }
+#endif
+}
+
+// Тесты для вычислений во время компиляции
+namespace {
+constexpr RectangleShape<int> plate(Point<int>(0, 0), Point<int>(40, 0), Point<int>(40, 25), Point<int>(0, 25));
+static_assert(plate.isValid());
+static_assert(plate.area() == 1000);
+static_assert(plate.centroid() == Point<int>(20, 12));
+
+constexpr SquareShape<double> tile(Point<double>(0, 0), Point<double>(1.5, 0), Point<double>(1.5, 1.5), Point<double>(0, 1.5));
+static_assert(tile.isValid());
+static_assert(tile.area() == 2.25);
+
+constexpr TriangleShape<double> gusset(Point<double>(0, 0), Point<double>(3, 0), Point<double>(0, 4));
+static_assert(gusset.isValid());
+static_assert(gusset.area() > 6 - EPS && gusset.area() < 6 + EPS);
+
+static_assert(!TriangleShape<double>(Point<double>(0, 0), Point<double>(1, 1), Point<double>(2, 2)).isValid());
+static_assert(!SquareShape<float>(Point<float>(0, 0), Point<float>(2, 0), Point<float>(2, 1), Point<float>(0, 1)).isValid());
+static_assert(RectangleShape<float>().isValid() && RectangleShape<float>().area() == 2);
+} // namespace
+
+TEST(ConstexprTest, CompileTimeMatchesRuntime) {
+    constexpr double compileTime = gusset.area();
+    Triangle<double> runtime(gusset);
+    EXPECT_NEAR(runtime.calculateArea(), compileTime, 1e-12);
+    EXPECT_TRUE(runtime.checkValidity());
+
+    Rectangle<int> plateFigure(plate);
+    EXPECT_DOUBLE_EQ(plateFigure.calculateArea(), 1000.0);
+    EXPECT_EQ(plateFigure.getCentroid(), plate.centroid());
+
+    Square<double> tileFigure(tile);
+    EXPECT_DOUBLE_EQ(tileFigure.calculateArea(), tile.area());
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();